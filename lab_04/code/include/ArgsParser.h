@@ -5,12 +5,20 @@
 #include <string>
 #include <vector>
 
+#include "Config.h"
+
 struct ProgramArgs {
     std::string input_file;
     std::string start_node;
     std::vector<std::string> target_nodes;
     int threads;
     bool run_experiments = false;// Новый флаг
+    std::string engine;          // пусто: linear при threads == 0, parallel иначе
+    int landmarks = Config::ALT_LANDMARKS;
+    std::string paths = "parents";// parents | lazy | none
+    std::string reorder;          // пусто: исходные номера; bfs | rcm | degree
+    bool partition = false;       // владельцы вершин по разбиению графа (engine=parallel)
+    bool verify = false;          // проверять контрольную сумму бинарного снимка
 
     bool valid() const {
         if (run_experiments) return true;
@@ -25,5 +33,6 @@ public:
 private:
     static void validate_args(const ProgramArgs &args);
     static std::vector<std::string> split_csv(const std::string &s);
+    static void parse_option(ProgramArgs &args, const std::string &opt);
     static void print_usage(const std::string &program_name);
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -8,4 +9,30 @@ namespace Config {
     constexpr uint64_t INF_LIKE = std::numeric_limits<uint64_t>::max() / 2;
     constexpr int DEFAULT_THREADS = 0;
     constexpr int MAX_THREADS = 64;
+    // MultiQueue параллельного Дейкстры: очередей на поток и шаг выборки ошибки ранга
+    constexpr int PAR_QUEUE_FACTOR = 2;
+    constexpr uint64_t PAR_RANK_SAMPLE = 64;
+    // Вставок в буфере потока до сброса в очередь
+    constexpr int PAR_PUSH_BATCH = 64;
+    // Разбиение на части потоков: раунды распространения меток и допустимый перекос размеров
+    constexpr int PARTITION_ROUNDS = 8;
+    constexpr double PARTITION_IMBALANCE = 0.03;
+    // Источников в группе многоисточникового поиска: 8 x 64 бита — один регистр AVX-512
+    constexpr int BATCH_LANES = 8;
+    // Предел плотного движка: матрица весов u32 на 8192 вершины — 256 МБ
+    constexpr size_t DENSE_MAX_VERTICES = 8192;
+    constexpr size_t PARALLEL_LOAD_MIN_BYTES = 1 << 20;
+    constexpr int HEAP_ARITY = 4;
+    // До этого максимального веса дуги используются корзины Дайала, выше — radix-куча
+    constexpr uint32_t DIAL_MAX_WEIGHT = 1 << 12;
+    constexpr int ALT_LANDMARKS = 8;
+    // Предел извлечённых вершин в поиске свидетеля при построении CH
+    constexpr int CH_WITNESS_SETTLE_LIMIT = 500;
+    // Вершины с in * out больше порога не сжимаются и образуют ядро CH
+    constexpr uint64_t CH_CORE_DEGREE = 1 << 12;
+    // Δ-stepping: Δ — квантиль весов, под которым в среднем столько дуг вершины
+    constexpr double DELTA_LIGHT_EDGES = 4.0;
+    constexpr size_t DELTA_WEIGHT_SAMPLE = 1 << 16;
+    // Корзин в кольце Δ-stepping; записи дальше кольца ждут в списке переполнения
+    constexpr size_t DELTA_RING_BUCKETS = 1024;
 }// namespace Config
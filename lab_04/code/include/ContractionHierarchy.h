@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "CsrGraph.h"
+
+// Рёбра иерархии в формате CSR. middle — сжатая вершина, через которую
+// проходит shortcut, или -1 для исходной дуги.
+class ChEdges {
+public:
+    std::vector<uint64_t> offsets;
+    std::vector<int> targets;
+    std::vector<int> middles;
+    std::vector<uint64_t> weights;
+};
+
+// Заголовок файла иерархии (.ch). За ним секции с выравниванием 8 байт:
+// rank[n] i32 | up: offsets[n+1] u64, targets i32, middles i32, weights u64 |
+// down: то же. Размеры и max_weight графа служат для отбраковки чужого файла.
+class ChHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t max_weight;
+    uint64_t up_edges;
+    uint64_t down_edges;
+    uint64_t reserved[1];
+};
+
+// Contraction hierarchies: вершины сжимаются в порядке edge difference
+// (число shortcut-ов минус число удаляемых дуг плюс число уже сжатых соседей),
+// shortcut добавляется, если поиск свидетеля с ограничением не нашёл пути не
+// длиннее. up хранит дуги u -> v с rank[u] < rank[v] у вершины u; down — дуги
+// u -> v с rank[u] > rank[v] у вершины v (targets = u), т.е. «вверх» назад.
+// Вершины, у которых к моменту сжатия in * out больше core_degree, остаются
+// несжатым ядром со старшими рангами; дуги ядра лежат и в up, и в down.
+class ContractionHierarchy {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    static ContractionHierarchy build(const CsrGraph &g, uint64_t core_degree = Config::CH_CORE_DEGREE);
+
+    void save(const std::string &path) const;
+    static ContractionHierarchy load(const std::string &path, const CsrGraph &g);
+
+    size_t size() const { return rank_.size(); }
+    int rank(int v) const { return rank_[v]; }
+    // Вершины по убыванию ранга (порядок важности для меток)
+    std::vector<int> order() const;
+    const ChEdges &up() const { return up_; }
+    const ChEdges &down() const { return down_; }
+    size_t shortcut_count() const;
+
+    // Разворачивает ребро иерархии u -> v в исходные дуги: дописывает в path
+    // пары (вершина, вес дуги в неё) для всех вершин после u
+    void unpack(int u, int v, int middle, uint64_t weight, std::vector<std::pair<int, uint64_t>> &path) const;
+
+private:
+    size_t m_ = 0;
+    uint32_t max_weight_ = 0;
+    std::vector<int> rank_;
+    ChEdges up_;
+    ChEdges down_;
+
+    int middle_of(const ChEdges &edges, int at, int target, uint64_t &weight) const;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+#include "Landmarks.h"
+
+// A* с оценкой ALT (ориентиры и неравенство треугольника): запрос на каждую
+// цель, остановка при извлечении цели. Оценка согласована, поэтому каждая
+// извлечённая вершина окончательна. В результате достоверны dist целей и
+// извлечённых вершин; parent ведёт от каждой достижимой цели к start.
+class DijkstraAlt {
+public:
+    DijkstraAlt(const CsrGraph &g, const Landmarks &landmarks, int start);
+    // Без целей выполняется обычный поиск по всему графу
+    void set_targets(const std::vector<int> &targets);
+    DijkstraResult run();
+
+private:
+    const CsrGraph &g_;
+    const Landmarks &lm_;
+    int start_;
+    std::vector<int> targets_;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+
+class Graph;
+
+// Поиск из нескольких источников за один обход графа. Источники идут группами
+// по Config::BATCH_LANES; у вершины — вектор расстояний группы (строка на
+// кэш-линию), релаксация дуги — векторные сложение и min по всем источникам
+// сразу. Вершина встаёт в очередь, если улучшилась хотя бы одна дорожка, с
+// ключом — наименьшим улучшенным расстоянием; при извлечении она
+// релаксирует все дорожки, поэтому для далёких друг от друга источников
+// вершины просматриваются повторно. Досрочной остановки по целям нет.
+class DijkstraBatch {
+public:
+    DijkstraBatch(const Graph &g, std::vector<int> sources);
+    DijkstraBatch(const CsrGraph &g, std::vector<int> sources);
+    // Родители пишутся векторно вместе с расстояниями; без них строка вершины
+    // короче вдвое по трафику
+    void set_record_parents(bool record);
+    // Результат i — для sources[i]
+    std::vector<DijkstraResult> run();
+
+private:
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
+    std::vector<int> sources_;
+    bool record_parents_ = true;
+};
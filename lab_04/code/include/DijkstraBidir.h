@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+
+class Graph;
+
+// Двунаправленный Дейкстра: прямой поиск из start и обратный из цели по
+// транспонированному графу, остановка при topF + topB >= mu. Для нескольких
+// целей выполняется по запросу на цель. В результате достоверны dist целей и
+// вершин найденных путей; parent ведёт от каждой достижимой цели к start.
+class DijkstraBidirectional {
+public:
+    DijkstraBidirectional(const Graph &g, int start);
+    DijkstraBidirectional(const CsrGraph &g, int start);
+    // Без целей выполняется обычный однонаправленный поиск
+    void set_targets(const std::vector<int> &targets);
+    // Строит обратный граф заранее (иначе — при первом run)
+    void prepare();
+    DijkstraResult run();
+
+private:
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
+    std::unique_ptr<CsrGraph> reverse_;// строится при первом запросе
+    int start_;
+    std::vector<int> targets_;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+
+class Graph;
+
+// Последовательный Дейкстра на монотонных целочисленных очередях.
+// При малом максимальном весе дуги C — циклические корзины Дайала
+// (O(m + n·C) в худшем случае), иначе radix-куча (O(m + n log C)).
+class DijkstraBucket {
+public:
+    enum class Strategy { Auto, Dial, Radix };
+
+    DijkstraBucket(const Graph &g, int start, Strategy strategy = Strategy::Auto);
+    DijkstraBucket(const CsrGraph &g, int start, Strategy strategy = Strategy::Auto);
+    void set_targets(const std::vector<int> &targets);
+    DijkstraResult run();
+
+    // Фактически используемая стратегия (Auto уже разрешён)
+    Strategy strategy() const { return strategy_; }
+
+private:
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
+    int start_;
+    std::vector<int> targets_;
+    Strategy strategy_;
+
+    DijkstraResult run_dial();
+    DijkstraResult run_radix();
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "ContractionHierarchy.h"
+#include "DijkstraSeq.h"
+
+// Запрос по contraction hierarchies: двунаправленный поиск только вверх по
+// рангам, каждое направление идёт, пока его минимум меньше mu. Найденный путь
+// разворачивается до исходных дуг; в результате достоверны dist целей и
+// вершин путей, parent ведёт от каждой достижимой цели к start.
+class DijkstraCh {
+public:
+    DijkstraCh(const ContractionHierarchy &ch, int start);
+    void set_targets(const std::vector<int> &targets);
+    DijkstraResult run();
+
+private:
+    const ContractionHierarchy &ch_;
+    int start_;
+    std::vector<int> targets_;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraPar.h"
+#include "QueryWorkspace.h"
+
+class Graph;
+
+// Δ-stepping (Meyer, Sanders): корзины ширины Δ обрабатываются по
+// возрастанию. Внутри корзины фазы параллельно релаксируют лёгкие дуги
+// (w <= Δ), пока корзина не опустеет; затем один раз — тяжёлые дуги всех
+// вершин, удалённых из корзины. Потоки идут фазами через барьер.
+class DijkstraDelta {
+public:
+    // delta == 0 — выбрать Δ по распределению весов (choose_delta)
+    DijkstraDelta(const Graph &g, int start, int threads, uint64_t delta = 0);
+    DijkstraDelta(const CsrGraph &g, int start, int threads, uint64_t delta = 0);
+    void set_threads(int t);
+    // Остановка, когда номер текущей корзины выше корзин всех целей
+    void set_targets(const std::vector<int> &targets);
+    // Переставляет дуги каждой вершины: сначала лёгкие (иначе — при первом run)
+    void prepare();
+    DijkstraParResult run();
+    QueryView run(QueryWorkspace &ws);
+
+    uint64_t delta() const { return delta_; }
+
+    // Вес, ниже которого в среднем лежат Config::DELTA_LIGHT_EDGES дуг вершины
+    // (квантиль выборки весов): при Δ = 1/d для случайных весов число
+    // повторных релаксаций в корзине остаётся ограниченным
+    static uint64_t choose_delta(const CsrGraph &g);
+
+private:
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
+    int start_;
+    int threads_;
+    uint64_t delta_;
+    std::vector<int> targets_;
+    std::unique_ptr<CsrGraph> split_;// дуги вершины v: лёгкие в [off[v], light_end_[v]), затем тяжёлые
+    std::vector<uint64_t> light_end_;
+};
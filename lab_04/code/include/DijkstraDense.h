@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+
+// Матрица весов n x n для плотных графов: строка вершины — веса дуг во все
+// вершины (из кратных дуг — наименьший), отсутствующая дуга — MISSING.
+// Строки дополнены до кратного stride(), чтобы векторные ядра шли без хвоста.
+class DenseGraph {
+public:
+    static constexpr uint32_t MISSING = UINT32_MAX;
+
+    // invalid_argument, если вершин больше Config::DENSE_MAX_VERTICES или
+    // вес дуги совпадает с MISSING
+    explicit DenseGraph(const CsrGraph &g);
+
+    size_t size() const { return n_; }
+    size_t stride() const { return stride_; }
+    const uint32_t *row(int u) const { return w_.data() + static_cast<size_t>(u) * stride_; }
+
+private:
+    size_t n_ = 0;
+    size_t stride_ = 0;
+    std::vector<uint32_t> w_;
+};
+
+// Поиск с линейным выбором минимума по матрице: O(n^2) независимо от числа
+// дуг, что для плотного графа оптимально. Метка «окончательна» хранится
+// старшим битом расстояния, поэтому и выбор минимума, и обновление строки —
+// один проход по двум массивам векторными командами (клоны AVX-512, AVX2 и
+// базовый x86-64 выбираются по процессору при загрузке).
+class DijkstraDense {
+public:
+    DijkstraDense(const DenseGraph &g, int start);
+    // Как у DijkstraSequential: остановка после всех целей
+    void set_targets(const std::vector<int> &targets);
+    void set_record_parents(bool record);
+    DijkstraResult run();
+
+private:
+    const DenseGraph &g_;
+    int start_;
+    std::vector<int> targets_;
+    bool record_parents_ = true;
+};
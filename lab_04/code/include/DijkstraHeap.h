@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Config.h"
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+
+class Graph;
+
+// Последовательный Дейкстра на индексированной d-арной куче, O((n + m) log n)
+class DijkstraHeap {
+public:
+    DijkstraHeap(const Graph &g, int start, int arity = Config::HEAP_ARITY);
+    DijkstraHeap(const CsrGraph &g, int start, int arity = Config::HEAP_ARITY);
+    void set_targets(const std::vector<int> &targets);
+    DijkstraResult run();
+
+private:
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
+    int start_;
+    std::vector<int> targets_;
+    int arity_;
+
+    template<int D>
+    DijkstraResult run_with();
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "DijkstraSeq.h"
+#include "HubLabels.h"
+
+// Запрос по 2-hop меткам: расстояние до цели — одно слияние меток. Путь
+// восстанавливается по требованию от цели к start (recover_path), расстояния
+// до вершин-кандидатов берутся из меток. В результате достоверны dist целей и
+// вершин путей, parent ведёт от каждой достижимой цели к start.
+class DijkstraHub {
+public:
+    DijkstraHub(const HubLabels &labels, const CsrGraph &g, int start);
+    void set_targets(const std::vector<int> &targets);
+    // Без путей заполняются только dist целей
+    void set_recover_paths(bool recover);
+    // Строит обратный граф заранее (иначе — при первом run)
+    void prepare();
+    DijkstraResult run();
+
+private:
+    const HubLabels &labels_;
+    const CsrGraph &g_;
+    std::unique_ptr<CsrGraph> reverse_;
+    int start_;
+    std::vector<int> targets_;
+    bool recover_paths_ = true;
+};
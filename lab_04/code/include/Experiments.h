@@ -3,11 +3,22 @@
 #include <vector>
 #include <string>
 
-class Graph;
+#include "Graph.h"
+#include "QueryWorkspace.h"
+
+class CsrGraph;
 
 class ExperimentRunner {
 public:
     void run_comparative_analysis();
+    void run_load_benchmark(const std::string& filename, int runs, int load_threads);
+    void run_engine_benchmark(int runs);
+    void run_scheduler_benchmark(int runs);
+    void run_pool_benchmark(int queries);
+    void run_batch_benchmark(int runs);
+    void run_nearest_benchmark(int queries);
+    void run_reorder_benchmark(int runs);
+    void run_partition_benchmark(int runs);
 
 private:
     struct ExperimentResult {
@@ -25,10 +36,13 @@ private:
 
     std::vector<GraphInfo> generate_test_graphs();
     void generate_graph(int vertices, const std::string& filename);
+    Graph make_random_graph(int vertices, int out_degree, uint32_t seed);
+    Graph make_grid_graph(int side, uint32_t seed);
+    Graph load_graph_cached(const std::string& filename);
     int count_edges(const Graph& g);
     std::vector<int> generate_thread_counts(unsigned int logical_cores);
     ExperimentResult run_experiment_series(const GraphInfo& graph_info, int threads, int runs);
-    long long run_single_experiment(const Graph& g, int start_node, const std::vector<int>& target_nodes, int threads);
+    long long run_single_experiment(const CsrGraph& g, int start_node, const std::vector<int>& target_nodes, int threads);
     std::vector<int> load_target_nodes(const Graph& g, const std::string& graph_filename);
     int find_start_node(const Graph& g);
     std::vector<int> find_target_nodes(const Graph& g, int count);
@@ -37,4 +51,7 @@ private:
     void analyze_overhead(const std::vector<ExperimentResult>& results);
     void analyze_scalability(const std::vector<ExperimentResult>& results, unsigned int logical_cores);
     void recommend_optimal_threads(const std::vector<ExperimentResult>& results, unsigned int logical_cores);
+
+    // Общие для серии запусков массивы запросов
+    QueryWorkspace workspace_;
 };
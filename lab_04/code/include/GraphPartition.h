@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Config.h"
+#include "CsrGraph.h"
+
+// Разбиение вершин на части для параллельного движка: часть i — вершины,
+// которыми владеет поток i. Начальные части — равные отрезки порядка обхода
+// в ширину, затем раунды распространения меток: вершина переходит в часть,
+// куда ведёт больше всего её дуг (в обе стороны), если та не переполнена.
+// Размер части не превышает n / parts * (1 + Config::PARTITION_IMBALANCE).
+class GraphPartition {
+public:
+    // invalid_argument при parts < 1
+    static GraphPartition build(const CsrGraph &g, int parts, int rounds = Config::PARTITION_ROUNDS);
+
+    int parts() const { return parts_; }
+    size_t size() const { return part_.size(); }
+    int part(int v) const { return part_[v]; }
+
+    // Дуги между разными частями и их доля среди всех дуг
+    uint64_t cut_edges() const { return cut_; }
+    double cut_fraction() const { return edges_ ? static_cast<double>(cut_) / static_cast<double>(edges_) : 0.0; }
+
+private:
+    int parts_ = 1;
+    std::vector<int> part_;
+    uint64_t cut_ = 0;
+    uint64_t edges_ = 0;
+};
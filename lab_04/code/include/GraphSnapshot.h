@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "CsrGraph.h"
+
+class Graph;
+class MappedFile;
+
+// Бинарный снимок графа (версия 2). Все секции выровнены на 8 байт:
+//   заголовок | offsets[n+1] u64 | targets[m] i32 | weights[m] u32 |
+//   name_offsets[n+1] u64 | name_order[n] i32 | names[names_bytes]
+// name_order — индексы вершин, отсортированные по имени (для бинпоиска).
+// checksum считается по всем байтам после заголовка. Версия 2 добавила
+// max_weight; в файлах версии 1 это поле нулевое и вычисляется при открытии.
+class SnapshotHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t names_bytes;
+    uint64_t checksum;
+    uint64_t max_weight;
+    uint64_t reserved[1];
+};
+
+// Снимок, открытый через mmap: массивы CSR и имена используются на месте.
+class GraphSnapshot {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    // Без verify — только заголовок, размеры и структура (смещения, номера
+    // вершин); verify добавляет контрольную сумму по всему файлу
+    static GraphSnapshot open(const std::string &path, bool verify = false);
+    static void save(const Graph &g, const std::string &path);
+    static bool is_snapshot(const std::string &path);
+
+    const CsrGraph &csr() const { return csr_; }
+    size_t size() const { return csr_.size(); }
+
+    std::optional<int> find_node(std::string_view name) const;
+    std::string_view name(int v) const;
+
+    Graph to_graph() const;
+
+private:
+    std::shared_ptr<const MappedFile> file_;
+    CsrGraph csr_;
+    const uint64_t *name_offsets_ = nullptr;
+    const int *name_order_ = nullptr;
+    const char *names_ = nullptr;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CsrGraph.h"
+
+// Заголовок файла меток (.hub). За ним секции с выравниванием 8 байт:
+// out: offsets[n+1] u64, hubs i32, dist u64 | in: то же. Хабы — номера
+// вершин в порядке важности, внутри метки строго возрастают. Размеры и
+// max_weight графа служат для отбраковки чужого файла.
+class HubHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t max_weight;
+    uint64_t out_entries;
+    uint64_t in_entries;
+    uint64_t reserved[1];
+};
+
+// Одна сторона меток в формате CSR: для вершины v пары (hubs[i], dist[i]),
+// i в [offsets[v], offsets[v+1])
+class HubLabelSet {
+public:
+    const uint64_t *offsets = nullptr;
+    const int *hubs = nullptr;
+    const uint64_t *dist = nullptr;
+};
+
+// 2-hop метки, построенные pruned landmark labeling: out(v) содержит d(v, h),
+// in(v) — d(h, v), и d(s, t) = min по общим хабам out(s) и in(t) — слияние
+// двух отсортированных массивов. Открытый файл используется на месте через mmap.
+class HubLabels {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // order — вершины по убыванию важности; метки тем меньше, чем раньше
+    // в порядке стоят вершины, через которые проходит много кратчайших путей
+    static HubLabels build(const CsrGraph &g, const std::vector<int> &order);
+
+    void save(const std::string &path) const;
+    static HubLabels open(const std::string &path, const CsrGraph &g);
+
+    size_t size() const { return n_; }
+    uint64_t entries() const { return out_.offsets[n_] + in_.offsets[n_]; }
+
+    // d(s, t); Config::INF, если t из s недостижима
+    uint64_t distance(int s, int t) const;
+
+private:
+    std::shared_ptr<const void> owner_;// отображённый файл или собственные массивы
+    size_t n_ = 0;
+    size_t m_ = 0;
+    uint32_t max_weight_ = 0;
+    HubLabelSet out_;
+    HubLabelSet in_;
+};
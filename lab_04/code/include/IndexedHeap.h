@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Индексированная d-арная min-куча по ключам uint64_t с операцией
+// decrease-key: каждая вершина присутствует в куче не более одного раза.
+template<int D>
+class IndexedDaryHeap {
+public:
+    explicit IndexedDaryHeap(int n) : pos_(n, -1) {}
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    bool contains(int v) const { return pos_[v] >= 0; }
+    uint64_t top_key() const { return heap_[0].key; }
+
+    // Опустошение за время, пропорциональное числу оставшихся элементов
+    void clear() {
+        for (const auto &e: heap_) {
+            pos_[e.v] = -1;
+        }
+        heap_.clear();
+    }
+
+    void push_or_decrease(int v, uint64_t key) {
+        int i = pos_[v];
+        if (i < 0) {
+            i = static_cast<int>(heap_.size());
+            heap_.push_back({key, v});
+        } else if (key < heap_[i].key) {
+            heap_[i].key = key;
+        } else {
+            return;
+        }
+        sift_up(i);
+    }
+
+    std::pair<int, uint64_t> pop() {
+        Entry top = heap_[0];
+        pos_[top.v] = -1;
+        Entry last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            sift_down(0);
+        }
+        return {top.v, top.key};
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        int v;
+    };
+
+    std::vector<Entry> heap_;
+    std::vector<int> pos_;
+
+    void sift_up(int i) {
+        Entry e = heap_[i];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (heap_[p].key <= e.key) {
+                break;
+            }
+            heap_[i] = heap_[p];
+            pos_[heap_[i].v] = i;
+            i = p;
+        }
+        heap_[i] = e;
+        pos_[e.v] = i;
+    }
+
+    void sift_down(int i) {
+        const int n = static_cast<int>(heap_.size());
+        Entry e = heap_[i];
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n) {
+                break;
+            }
+            int last = first + D < n ? first + D : n;
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (heap_[c].key < heap_[best].key) {
+                    best = c;
+                }
+            }
+            if (heap_[best].key >= e.key) {
+                break;
+            }
+            heap_[i] = heap_[best];
+            pos_[heap_[i].v] = i;
+            i = best;
+        }
+        heap_[i] = e;
+        pos_[e.v] = i;
+    }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -9,6 +10,8 @@
 
 class JsonResultBuilder {
 public:
+    using NameLookup = std::function<std::string(int)>;
+
     JsonResultBuilder() = default;
 
     void build(const Graph &g,
@@ -19,6 +22,18 @@ public:
                const std::vector<int> &parent,
                int threads,
                long long elapsed,
+               uint64_t settled,
+               bool use_seq);
+
+    void build(const NameLookup &name_of,
+               const std::string &start_name,
+               const std::vector<std::string> &target_names,
+               const std::vector<int> &target_ids,
+               const std::vector<uint64_t> &dist,
+               const std::vector<int> &parent,
+               int threads,
+               long long elapsed,
+               uint64_t settled,
                bool use_seq);
 
     std::string get_result() const {
@@ -36,11 +51,11 @@ private:
     void escape_json(const std::string &s);
     void build_header(const std::string &start_name,
                       const std::vector<std::string> &target_names,
-                      int threads, long long elapsed, bool use_seq);
+                      int threads, long long elapsed, uint64_t settled, bool use_seq);
     void build_distances(const std::vector<std::string> &target_names,
                          const std::vector<int> &target_ids,
                          const std::vector<uint64_t> &dist);
-    void build_shortest_path(const Graph &g,
+    void build_shortest_path(const NameLookup &name_of,
                              const std::vector<std::string> &target_names,
                              const std::vector<int> &target_ids,
                              const std::vector<uint64_t> &dist,
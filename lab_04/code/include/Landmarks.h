@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CsrGraph.h"
+
+// Заголовок файла ориентиров (.alt). За ним: landmarks[k] i32 (с выравниванием
+// до 8 байт), from[n·k] u64, to[n·k] u64. Размеры и max_weight графа служат
+// для отбраковки файла, построенного по другому графу.
+class LandmarkHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t max_weight;
+    uint64_t count;
+    uint64_t reserved[2];
+};
+
+// Предобработка ALT: k ориентиров и расстояния от/до каждого из них.
+// Таблицы хранятся по вершинам (k значений подряд), чтобы оценка для
+// одной вершины читала одну строку кэша.
+class Landmarks {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // Выбор «самой дальней точки»: первый ориентир — самая дальняя от first
+    // вершина, каждый следующий максимизирует расстояние до уже выбранных
+    static Landmarks build(const CsrGraph &g, int count, int first = 0);
+
+    void save(const std::string &path) const;
+    static Landmarks load(const std::string &path, const CsrGraph &g);
+
+    size_t count() const { return ids_.size(); }
+    const std::vector<int> &ids() const { return ids_; }
+
+    // d(L_i, v) и d(v, L_i); Config::INF для недостижимых
+    uint64_t from(int landmark, int v) const { return from_[static_cast<size_t>(v) * count() + landmark]; }
+    uint64_t to(int landmark, int v) const { return to_[static_cast<size_t>(v) * count() + landmark]; }
+
+    // Нижняя оценка d(v, t) по неравенству треугольника; Config::INF, если
+    // таблицы доказывают, что t из v недостижима
+    uint64_t lower_bound(int v, int t) const;
+
+private:
+    size_t n_ = 0;
+    size_t m_ = 0;
+    uint32_t max_weight_ = 0;
+    std::vector<int> ids_;
+    std::vector<uint64_t> from_;
+    std::vector<uint64_t> to_;
+};
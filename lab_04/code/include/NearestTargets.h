@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CsrGraph.h"
+
+// Заголовок файла таблицы ближайших целей (.near). За ним: targets[k] i32 (с
+// выравниванием до 8 байт), dist[n] u64, nearest[n] i32, next[n] i32. Размеры
+// и max_weight графа служат для отбраковки файла другого графа.
+class NearestHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t max_weight;
+    uint64_t count;
+    uint64_t reserved[2];
+};
+
+// Расстояние от каждой вершины до ближайшей помеченной: один поиск по
+// обратному графу сразу из всех целей. Таблица зависит только от набора
+// целей, поэтому запрос из любой вершины — переход по ссылкам next вдоль
+// пути. При равных расстояниях выигрывает цель, стоящая в списке раньше,
+// как при выборе кратчайшей цели по результату обычного поиска.
+class NearestTargets {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // Повторы в targets отбрасываются; номера вне графа — invalid_argument
+    static NearestTargets build(const CsrGraph &g, const std::vector<int> &targets);
+
+    void save(const std::string &path) const;
+    static NearestTargets load(const std::string &path, const CsrGraph &g);
+
+    size_t size() const { return n_; }
+    // Цели в порядке первого появления
+    const std::vector<int> &targets() const { return targets_; }
+    // Таблица построена для того же списка целей (с точностью до повторов)
+    bool built_for(const std::vector<int> &targets) const;
+
+    // d(v, nearest(v)); Config::INF, если из v ни одна цель не достижима
+    uint64_t distance(int v) const { return dist_[v]; }
+    // Ближайшая цель или -1
+    int nearest(int v) const { return nearest_[v]; }
+    // Кратчайший путь v -> nearest(v); пустой, если целей не достичь
+    std::vector<int> path(int v) const;
+
+private:
+    size_t n_ = 0;
+    size_t m_ = 0;
+    uint32_t max_weight_ = 0;
+    std::vector<int> targets_;
+    std::vector<uint64_t> dist_;
+    std::vector<int> nearest_;
+    std::vector<int> next_;// следующая вершина пути к цели, -1 у самих целей
+};
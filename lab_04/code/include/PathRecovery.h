@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "CsrGraph.h"
+
+// Путь start -> target по расстояниям без массива parent: предок v — входящий
+// сосед p с dist(p) + w(p, v) = dist(v). reverse — обратный граф (входящие
+// дуги), dist должен быть точен для вершин подходящих предков (так у любого
+// поиска, остановленного после target). Пустой путь — target недостижима;
+// runtime_error — расстояния не согласованы с графом.
+std::vector<int> recover_path(const CsrGraph &reverse, int start, int target,
+                              const std::function<uint64_t(int)> &dist);
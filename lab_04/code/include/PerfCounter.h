@@ -0,0 +1,22 @@
+#pragma once
+
+// Аппаратный счётчик промахов кэша (последнего уровня) вызывающего потока
+// через perf_event_open. Без PMU (виртуальная машина, контейнер), при
+// kernel.perf_event_paranoid > 2 или не на Linux счётчик недоступен:
+// available() == false, stop() возвращает -1.
+class PerfCounter {
+public:
+    PerfCounter();
+    ~PerfCounter();
+    PerfCounter(const PerfCounter &) = delete;
+    PerfCounter &operator=(const PerfCounter &) = delete;
+
+    bool available() const { return fd_ != -1; }
+    // Обнуляет и запускает счёт
+    void start();
+    // Останавливает счёт и возвращает число событий с последнего start
+    long long stop();
+
+private:
+    int fd_ = -1;
+};
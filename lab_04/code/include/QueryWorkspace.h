@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Config.h"
+
+// Рабочие массивы запроса, которыми владеет вызывающий и которые
+// переиспользуются между запросами. Значения вершины действительны, только
+// если её метка равна текущей эпохе, поэтому begin() перед запросом — O(1);
+// полная очистка нужна лишь при смене размера и переполнении счётчика эпох.
+class QueryWorkspace {
+public:
+    QueryWorkspace() = default;
+    explicit QueryWorkspace(size_t n) { begin(n); }
+
+    QueryWorkspace(const QueryWorkspace &) = delete;
+    QueryWorkspace &operator=(const QueryWorkspace &) = delete;
+
+    // Начинает новый запрос на графе из n вершин; прежние виды становятся
+    // недействительны. Без parents родители не записываются и parent() == -1
+    void begin(size_t n, bool parents = true);
+
+    // Запрос параллельного движка с (dist, parent) в одном 64-битном слове:
+    // 32 + 32 бита, если расстояния не превышают dist_bound < 2^32, иначе
+    // 40 + 24 при n < 2^24; без parents слово целиком отдано расстоянию.
+    // Слова не имеют меток эпох, поэтому перед запросом их заполняет reset
+    // по диапазонам (параллельно у вызывающего). Если размеры не помещаются,
+    // остаётся широкий режим begin(n)
+    void begin_packed(size_t n, uint64_t dist_bound, bool parents = true);
+    // Очищает слова [lo, hi) упакованного режима
+    void reset(size_t lo, size_t hi);
+    bool packed() const { return packed_mode_; }
+    // Бит на родителя в упакованном слове
+    int parent_bits() const { return parent_bits_; }
+    bool parents() const { return parents_; }
+
+    size_t size() const { return dist_.size(); }
+
+    bool reached(int v) const { return packed_mode_ ? word(v) != empty_ : stamp_[v] == epoch_; }
+    uint64_t dist(int v) const {
+        if (packed_mode_) {
+            return word(v) != empty_ ? word(v) >> parent_bits_ : Config::INF;
+        }
+        return reached(v) ? dist_[v] : Config::INF;
+    }
+    int parent(int v) const {
+        if (!parents_ || !reached(v)) {
+            return -1;
+        }
+        return packed_mode_ ? static_cast<int>(word(v) & parent_mask_) - 1 : parent_[v];
+    }
+    bool settled(int v) const { return done_[v] == epoch_; }
+
+    void reach(int v, uint64_t d, int parent) {
+        stamp_[v] = epoch_;
+        dist_[v] = d;
+        parent_[v] = parent;
+    }
+    // Только расстояние: для запроса без родителей
+    void reach(int v, uint64_t d) {
+        stamp_[v] = epoch_;
+        dist_[v] = d;
+    }
+    void settle(int v) { done_[v] = epoch_; }
+    // Потокобезопасная отметка: true только у первого отметившего вершину в этой эпохе
+    bool try_settle(int v) {
+        return std::atomic_ref<uint32_t>(done_[v]).exchange(epoch_, std::memory_order_relaxed) != epoch_;
+    }
+
+    // Доступ из нескольких потоков (параллельный движок). Первый поток,
+    // заставший устаревшую метку, захватывает вершину меткой BUSY, сбрасывает
+    // её значения и публикует текущую эпоху; остальные ждут публикации.
+    uint64_t load_dist(int v) {
+        if (packed_mode_) {
+            uint64_t w = std::atomic_ref<uint64_t>(packed_[v]).load(std::memory_order_relaxed);
+            return w != empty_ ? w >> parent_bits_ : Config::INF;
+        }
+        return claimed(v) ? std::atomic_ref<uint64_t>(dist_[v]).load(std::memory_order_relaxed) : Config::INF;
+    }
+
+    // Уменьшает расстояние до v, если nd меньше текущего; true — уменьшено.
+    // Упакованное слово и расстояние без родителей меняются одним CAS; в
+    // широком режиме пара (dist, parent) меняется под спин-блокировкой полосы
+    // вершины, иначе parent проигравшей гонки мог бы затереть parent меньшего
+    // расстояния
+    bool try_relax(int v, uint64_t nd, int parent) {
+        if (packed_mode_) {
+            std::atomic_ref<uint64_t> w(packed_[v]);
+            const uint64_t next = (nd << parent_bits_) | (static_cast<uint64_t>(parent + 1) & parent_mask_);
+            uint64_t cur = w.load(std::memory_order_relaxed);
+            while ((cur >> parent_bits_) > nd) {
+                if (w.compare_exchange_weak(cur, next, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        claim(v);
+        if (!parents_) {
+            std::atomic_ref<uint64_t> d(dist_[v]);
+            uint64_t cur = d.load(std::memory_order_relaxed);
+            while (nd < cur) {
+                if (d.compare_exchange_weak(cur, nd, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        std::atomic_ref<uint64_t> d(dist_[v]);
+        if (nd >= d.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        std::atomic<bool> &lock = locks_[static_cast<size_t>(v) % LOCK_STRIPES];
+        while (lock.exchange(true, std::memory_order_acquire)) {
+            while (lock.load(std::memory_order_relaxed)) {
+            }
+        }
+        bool improved = nd < d.load(std::memory_order_relaxed);
+        if (improved) {
+            d.store(nd, std::memory_order_relaxed);
+            std::atomic_ref<int>(parent_[v]).store(parent, std::memory_order_relaxed);
+        }
+        lock.store(false, std::memory_order_release);
+        return improved;
+    }
+
+private:
+    static constexpr uint32_t BUSY = UINT32_MAX;
+    static constexpr size_t LOCK_STRIPES = 1024;
+
+    std::vector<uint64_t> dist_;
+    std::vector<int> parent_;
+    std::vector<uint32_t> stamp_;
+    std::vector<uint32_t> done_;
+    uint32_t epoch_ = 0;
+    std::vector<std::atomic<bool>> locks_ = std::vector<std::atomic<bool>>(LOCK_STRIPES);
+
+    // Упакованный режим: родитель хранится как parent + 1, пустое слово — все единицы
+    std::unique_ptr<uint64_t[]> packed_;
+    size_t packed_size_ = 0;
+    bool packed_mode_ = false;
+    bool parents_ = true;
+    int parent_bits_ = 0;
+    uint64_t parent_mask_ = 0;
+    uint64_t empty_ = 0;
+
+    uint64_t word(int v) const { return packed_[v]; }
+
+    bool claimed(int v) {
+        std::atomic_ref<uint32_t> s(stamp_[v]);
+        uint32_t cur = s.load(std::memory_order_acquire);
+        while (cur == BUSY) {
+            cur = s.load(std::memory_order_acquire);
+        }
+        return cur == epoch_;
+    }
+
+    void claim(int v) {
+        std::atomic_ref<uint32_t> s(stamp_[v]);
+        uint32_t cur = s.load(std::memory_order_acquire);
+        while (cur != epoch_) {
+            if (cur != BUSY && s.compare_exchange_weak(cur, BUSY, std::memory_order_acquire)) {
+                std::atomic_ref<uint64_t>(dist_[v]).store(Config::INF, std::memory_order_relaxed);
+                std::atomic_ref<int>(parent_[v]).store(-1, std::memory_order_relaxed);
+                s.store(epoch_, std::memory_order_release);
+                return;
+            }
+            if (cur == BUSY) {
+                cur = s.load(std::memory_order_acquire);
+            }
+        }
+    }
+};
+
+// Результат запроса как вид на массивы workspace: действителен до следующего
+// begin() того же workspace
+class QueryView {
+public:
+    QueryView(const QueryWorkspace &ws, uint64_t settled) : ws_(&ws), settled_(settled) {}
+
+    size_t size() const { return ws_->size(); }
+    uint64_t dist(int v) const { return ws_->dist(v); }
+    int parent(int v) const { return ws_->parent(v); }
+    // Число вершин, расстояние до которых стало окончательным
+    uint64_t settled() const { return settled_; }
+
+    // Копии на весь граф, O(n)
+    std::vector<uint64_t> dist_vector() const;
+    std::vector<int> parent_vector() const;
+
+private:
+    const QueryWorkspace *ws_;
+    uint64_t settled_;
+};
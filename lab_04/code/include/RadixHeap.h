@@ -0,0 +1,51 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Монотонная radix-куча: извлекаемые ключи не убывают, а каждый новый ключ
+// не меньше последнего извлечённого. Корзина i хранит ключи, отличающиеся
+// от последнего извлечённого в старшем бите с номером i - 1.
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void push(uint64_t key, int v) {
+        buckets_[bucket_of(key)].push_back({key, v});
+        ++size_;
+    }
+
+    std::pair<int, uint64_t> pop() {
+        if (buckets_[0].empty()) {
+            int i = 1;
+            while (buckets_[i].empty()) {
+                ++i;
+            }
+            uint64_t min_key = buckets_[i][0].first;
+            for (const auto &e: buckets_[i]) {
+                min_key = e.first < min_key ? e.first : min_key;
+            }
+            last_ = min_key;
+            for (const auto &e: buckets_[i]) {
+                buckets_[bucket_of(e.first)].push_back(e);
+            }
+            buckets_[i].clear();
+        }
+        auto [key, v] = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        return {v, key};
+    }
+
+private:
+    std::vector<std::pair<uint64_t, int>> buckets_[65];
+    uint64_t last_ = 0;
+    size_t size_ = 0;
+
+    int bucket_of(uint64_t key) const {
+        return key == last_ ? 0 : 64 - std::countl_zero(key ^ last_);
+    }
+};
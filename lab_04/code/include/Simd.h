@@ -0,0 +1,17 @@
+#pragma once
+
+// Векторные ядра (DijkstraBatch, DijkstraDense) написаны на векторных
+// расширениях GCC: тернарный оператор над векторами и __builtin_convertvector.
+// Где их нет (Clang, MSVC) или при сборке с -DSIMD_SCALAR, ядра
+// собираются из скалярных циклов.
+#if defined(__GNUC__) && !defined(__clang__) && !defined(SIMD_SCALAR)
+#define SIMD_VECTOR_EXT 1
+#endif
+
+// Клоны под AVX-512, AVX2 и базовый x86-64 выбираются при загрузке по
+// возможностям процессора; target_clones есть только у GCC на x86-64 ELF
+#if defined(__x86_64__) && defined(__ELF__) && !defined(__clang__)
+#define SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SIMD_CLONES
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CsrGraph.h"
+
+// Перенумерация вершин для локальности: номера из DOT идут в порядке первого
+// упоминания, и у соседей по графу они обычно далеки, так что dist/parent
+// читаются вразброс. Порядок строится по неориентированному виду графа
+// (входящие и исходящие дуги) и хранит перестановку, чтобы имена, цели и
+// пути переводились обратно в исходные номера.
+class VertexOrder {
+public:
+    enum class Strategy {
+        Bfs,   // обход в ширину, компоненты — по возрастанию исходного номера
+        Rcm,   // обратный Катхилл–Макки: BFS от вершины наименьшей степени,
+               // соседи по возрастанию степени, итог в обратном порядке
+        Degree,// по убыванию степени: «горячие» вершины в начале массивов
+    };
+
+    // "bfs" | "rcm" | "degree"; иное — invalid_argument
+    static Strategy parse(const std::string &name);
+    static VertexOrder compute(const CsrGraph &g, Strategy strategy);
+
+    size_t size() const { return order_.size(); }
+    // order()[i] — исходный номер новой вершины i (аргумент CsrGraph::permuted)
+    const std::vector<int> &order() const { return order_; }
+    int to_new(int v) const { return rank_[v]; }
+    int to_old(int v) const { return order_[v]; }
+
+    // Результат поиска по перенумерованному графу — в исходные номера;
+    // пустой parent (режим без путей) остаётся пустым
+    void restore(std::vector<uint64_t> &dist, std::vector<int> &parent) const;
+
+private:
+    explicit VertexOrder(std::vector<int> order);
+
+    std::vector<int> order_;
+    std::vector<int> rank_;
+};
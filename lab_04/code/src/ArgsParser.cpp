@@ -20,6 +20,13 @@ ProgramArgs ArgsParser::parse(int argc, char **argv) {
         throw std::invalid_argument("Invalid threads value: " + std::string(e.what()));
     }
 
+    for (int i = 5; i < argc; ++i) {
+        parse_option(args, argv[i]);
+    }
+    if (args.engine.empty()) {
+        args.engine = args.threads == 0 ? "linear" : "parallel";
+    }
+
     validate_args(args);
     return args;
 }
@@ -46,6 +53,31 @@ void ArgsParser::validate_args(const ProgramArgs &args) {
         throw std::invalid_argument("Thread count too high (max 128)");
     }
 
+    bool seq_engine = args.engine == "linear" || args.engine == "dense" || args.engine == "heap" || args.engine == "bucket" ||
+                      args.engine == "bidir" || args.engine == "alt" || args.engine == "ch" ||
+                      args.engine == "hub" || args.engine == "nearest";
+    bool par_engine = args.engine == "parallel" || args.engine == "delta";
+    if (!seq_engine && !par_engine) {
+        throw std::invalid_argument("Unknown engine: " + args.engine);
+    }
+    if (par_engine && args.threads == 0) {
+        throw std::invalid_argument("Engine " + args.engine + " requires threads > 0");
+    }
+
+    if (args.paths != "parents" && args.paths != "lazy" && args.paths != "none") {
+        throw std::invalid_argument("Unknown path mode: " + args.paths);
+    }
+    if (!args.reorder.empty() && args.reorder != "bfs" && args.reorder != "rcm" && args.reorder != "degree") {
+        throw std::invalid_argument("Unknown vertex order: " + args.reorder);
+    }
+    if (args.partition && args.engine != "parallel") {
+        throw std::invalid_argument("--partition requires --engine=parallel");
+    }
+
+    if (args.landmarks < 1 || args.landmarks > 64) {
+        throw std::invalid_argument("Landmark count must be in [1, 64]");
+    }
+
     // Проверка на дубликаты в целевых узлах
     for (size_t i = 0; i < args.target_nodes.size(); ++i) {
         for (size_t j = i + 1; j < args.target_nodes.size(); ++j) {
@@ -56,6 +88,42 @@ void ArgsParser::validate_args(const ProgramArgs &args) {
     }
 }
 
+void ArgsParser::parse_option(ProgramArgs &args, const std::string &opt) {
+    const std::string engine_opt = "--engine=";
+    if (opt.compare(0, engine_opt.size(), engine_opt) == 0) {
+        args.engine = opt.substr(engine_opt.size());
+        return;
+    }
+    const std::string landmarks_opt = "--landmarks=";
+    if (opt.compare(0, landmarks_opt.size(), landmarks_opt) == 0) {
+        try {
+            args.landmarks = std::stoi(opt.substr(landmarks_opt.size()));
+        } catch (const std::exception &e) {
+            throw std::invalid_argument("Invalid landmarks value: " + std::string(e.what()));
+        }
+        return;
+    }
+    const std::string paths_opt = "--paths=";
+    if (opt.compare(0, paths_opt.size(), paths_opt) == 0) {
+        args.paths = opt.substr(paths_opt.size());
+        return;
+    }
+    if (opt == "--partition") {
+        args.partition = true;
+        return;
+    }
+    if (opt == "--verify") {
+        args.verify = true;
+        return;
+    }
+    const std::string reorder_opt = "--reorder=";
+    if (opt.compare(0, reorder_opt.size(), reorder_opt) == 0) {
+        args.reorder = opt.substr(reorder_opt.size());
+        return;
+    }
+    throw std::invalid_argument("Unknown option: " + opt);
+}
+
 std::vector<std::string> ArgsParser::split_csv(const std::string &s) {
     std::vector<std::string> out;
     std::stringstream ss(s);
@@ -78,13 +146,27 @@ std::vector<std::string> ArgsParser::split_csv(const std::string &s) {
 }
 
 void ArgsParser::print_usage(const std::string &program_name) {
-    std::cerr << "Usage: " << program_name << " <input.dot> <start> <targets_csv> <threads>\n"
+    std::cerr << "Usage: " << program_name << " <input.dot> <start> <targets_csv> <threads> [--engine=NAME]\n"
               << "\nArguments:\n"
-              << "  input.dot    Path to graph file in DOT format\n"
+              << "  input.dot    Path to graph file in DOT format (or binary snapshot from lab04_convert)\n"
               << "  start        Starting node name\n"
               << "  targets_csv  Comma-separated list of target nodes\n"
               << "  threads      Number of threads (0 for sequential, >0 for parallel)\n"
+              << "\nOptions:\n"
+              << "  --engine=NAME  Sequential: linear (default), dense, heap, bucket, bidir, alt, ch, hub, nearest; parallel: parallel (default), delta\n"
+              << "  --landmarks=K  Landmark count for --engine=alt (default " << Config::ALT_LANDMARKS << ")\n"
+              << "  --paths=MODE   parents (default): record parents during the search; lazy: distances only,\n"
+              << "                 the path is recovered from in-edges afterwards (linear, dense, parallel);\n"
+              << "                 none: distances only, no path in the output\n"
+              << "  --engine=nearest answers from a table of the nearest target of every vertex, cached next to\n"
+              << "                 the graph for the same target list; other targets get null distances\n"
+              << "  --reorder=ORD  Renumber vertices for cache locality before the search: bfs, rcm (reverse\n"
+              << "                 Cuthill-McKee) or degree; output keeps the original names\n"
+              << "  --partition    Parallel engine: give each thread a block of vertices found by label\n"
+              << "                 propagation, so most pushes stay in the thread's own queues\n"
+              << "  --verify       Check the binary snapshot checksum on open (reads the whole file)\n"
               << "\nExamples:\n"
               << "  " << program_name << " graph.dot A \"X,Y,Z\" 4\n"
-              << "  " << program_name << " graph.dot \"Node A\" \"Target 1,Target 2\" 0\n";
+              << "  " << program_name << " graph.dot \"Node A\" \"Target 1,Target 2\" 0\n"
+              << "  " << program_name << " graph.dot A \"X,Y,Z\" 0 --engine=heap\n";
 }
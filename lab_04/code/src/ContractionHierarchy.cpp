@@ -0,0 +1,444 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+
+#include "Config.h"
+#include "IndexedHeap.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'I', 'U', '7', 'C', 'H', 'I', 'E', 'R'};
+
+    size_t align8(size_t x) {
+        return (x + 7) & ~static_cast<size_t>(7);
+    }
+
+    class Arc {
+    public:
+        int to;
+        int middle;
+        uint64_t w;
+    };
+
+    class Shortcut {
+    public:
+        int from;
+        int to;
+        uint64_t w;
+    };
+
+    // Остаточный граф на время сжатия: входящие и исходящие дуги без петель
+    // и кратных дуг (остаётся самая лёгкая)
+    class ChBuilder {
+    public:
+        explicit ChBuilder(const CsrGraph &g)
+            : n_(static_cast<int>(g.size())), out_(n_), in_(n_), contracted_(n_, 0), deleted_(n_, 0),
+              dist_(n_, Config::INF), need_(n_, Config::INF), heap_(n_) {
+            const uint64_t *off = g.offsets();
+            const int *to = g.targets();
+            const uint32_t *wt = g.weights();
+            for (int u = 0; u < n_; ++u) {
+                auto &arcs = out_[u];
+                for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                    if (to[e] != u) {
+                        arcs.push_back({to[e], -1, wt[e]});
+                    }
+                }
+                std::sort(arcs.begin(), arcs.end(), [](const Arc &a, const Arc &b) {
+                    return a.to != b.to ? a.to < b.to : a.w < b.w;
+                });
+                arcs.erase(std::unique(arcs.begin(), arcs.end(), [](const Arc &a, const Arc &b) { return a.to == b.to; }),
+                           arcs.end());
+                for (const Arc &a: arcs) {
+                    in_[a.to].push_back({u, -1, a.w});
+                }
+            }
+        }
+
+        void run(uint64_t core_degree, std::vector<int> &rank, std::vector<std::vector<Arc>> &up,
+                 std::vector<std::vector<Arc>> &down) {
+            rank.assign(n_, -1);
+            up.assign(n_, {});
+            down.assign(n_, {});
+
+            // Начальный приоритет — оценка без поиска свидетелей (все пары
+            // соседей дают shortcut); точное значение считается при извлечении
+            using Item = std::pair<long long, int>;
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> order;
+            for (int v = 0; v < n_; ++v) {
+                long long in = static_cast<long long>(in_[v].size());
+                long long out = static_cast<long long>(out_[v].size());
+                order.push({in * out - in - out, v});
+            }
+
+            int next_rank = 0;
+            std::vector<int> core;
+            while (!order.empty()) {
+                auto [p, v] = order.top();
+                order.pop();
+                if (contracted_[v]) {
+                    continue;
+                }
+                if (static_cast<uint64_t>(in_[v].size()) * out_[v].size() > core_degree) {
+                    contracted_[v] = 1;
+                    core.push_back(v);
+                    continue;
+                }
+                long long actual = priority(v);
+                if (!order.empty() && actual > order.top().first) {
+                    order.push({actual, v});
+                    continue;
+                }
+                rank[v] = next_rank++;
+                up[v] = out_[v];
+                down[v] = in_[v];
+                contract(v);
+            }
+
+            // Ядро остаётся несжатым и получает старшие ранги; его дуги лежат
+            // и в up, и в down, так что внутри ядра запрос идёт обычным
+            // двунаправленным Дейкстрой
+            for (int v: core) {
+                rank[v] = next_rank++;
+                up[v] = std::move(out_[v]);
+                down[v] = std::move(in_[v]);
+            }
+        }
+
+    private:
+        int n_;
+        std::vector<std::vector<Arc>> out_;
+        std::vector<std::vector<Arc>> in_;
+        std::vector<char> contracted_;
+        std::vector<int> deleted_;
+
+        std::vector<uint64_t> dist_;
+        std::vector<uint64_t> need_;// длина пути через сжимаемую вершину; INF — свидетель найден
+        std::vector<std::pair<uint64_t, int>> needs_;
+        std::vector<int> touched_;
+        IndexedDaryHeap<Config::HEAP_ARITY> heap_;
+        std::vector<Shortcut> pending_;
+
+        long long priority(int v) {
+            long long shortcuts = static_cast<long long>(find_shortcuts(v));
+            long long removed = static_cast<long long>(in_[v].size() + out_[v].size());
+            return shortcuts - removed + deleted_[v];
+        }
+
+        // Дейкстра из u в остаточном графе без вершины skip, не более
+        // Config::CH_WITNESS_SETTLE_LIMIT извлечённых вершин. Свидетелю достаточно
+        // любого пути не длиннее need_, поэтому хватает предварительного
+        // расстояния. Поиск заканчивается, когда извлечённое расстояние больше
+        // наибольшей need_ среди целей без свидетеля (needs_ отсортирован по убыванию).
+        void witness_search(int u, int skip) {
+            dist_[u] = 0;
+            touched_.push_back(u);
+            heap_.push_or_decrease(u, 0);
+            size_t open = 0;
+            int settled = 0;
+            while (!heap_.empty() && settled < Config::CH_WITNESS_SETTLE_LIMIT) {
+                while (open < needs_.size() && need_[needs_[open].second] == Config::INF) {
+                    ++open;
+                }
+                if (open == needs_.size() || heap_.top_key() > needs_[open].first) {
+                    break;
+                }
+                auto [x, d] = heap_.pop();
+                ++settled;
+                for (const Arc &a: out_[x]) {
+                    if (a.to == skip) {
+                        continue;
+                    }
+                    uint64_t nd = d + a.w;
+                    if (nd < dist_[a.to]) {
+                        if (dist_[a.to] == Config::INF) {
+                            touched_.push_back(a.to);
+                        }
+                        dist_[a.to] = nd;
+                        heap_.push_or_decrease(a.to, nd);
+                        if (nd <= need_[a.to] && need_[a.to] != Config::INF) {
+                            need_[a.to] = Config::INF;
+                        }
+                    }
+                }
+            }
+            heap_.clear();
+        }
+
+        void reset_search() {
+            for (int x: touched_) {
+                dist_[x] = Config::INF;
+            }
+            touched_.clear();
+        }
+
+        // Заполняет pending_ shortcut-ами, нужными при сжатии v
+        size_t find_shortcuts(int v) {
+            pending_.clear();
+            for (const Arc &a: in_[v]) {
+                needs_.clear();
+                for (const Arc &b: out_[v]) {
+                    if (b.to != a.to) {
+                        need_[b.to] = a.w + b.w;
+                        needs_.emplace_back(a.w + b.w, b.to);
+                    }
+                }
+                std::sort(needs_.begin(), needs_.end(), std::greater<>());
+                witness_search(a.to, v);
+                for (const Arc &b: out_[v]) {
+                    if (need_[b.to] != Config::INF) {
+                        pending_.push_back({a.to, b.to, a.w + b.w});
+                        need_[b.to] = Config::INF;
+                    }
+                }
+                reset_search();
+            }
+            return pending_.size();
+        }
+
+        static void erase_arc(std::vector<Arc> &arcs, int to) {
+            for (size_t i = 0; i < arcs.size(); ++i) {
+                if (arcs[i].to == to) {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+            }
+        }
+
+        static void relax_arc(std::vector<Arc> &arcs, int to, int middle, uint64_t w) {
+            for (Arc &a: arcs) {
+                if (a.to == to) {
+                    if (w < a.w) {
+                        a.w = w;
+                        a.middle = middle;
+                    }
+                    return;
+                }
+            }
+            arcs.push_back({to, middle, w});
+        }
+
+        // pending_ уже заполнен вызовом priority(v) непосредственно перед сжатием
+        void contract(int v) {
+            contracted_[v] = 1;
+            for (const Arc &b: out_[v]) {
+                erase_arc(in_[b.to], v);
+                ++deleted_[b.to];
+            }
+            for (const Arc &a: in_[v]) {
+                erase_arc(out_[a.to], v);
+                ++deleted_[a.to];
+            }
+            for (const Shortcut &s: pending_) {
+                relax_arc(out_[s.from], s.to, v, s.w);
+                relax_arc(in_[s.to], s.from, v, s.w);
+            }
+            out_[v].clear();
+            out_[v].shrink_to_fit();
+            in_[v].clear();
+            in_[v].shrink_to_fit();
+        }
+    };
+
+    ChEdges to_csr(const std::vector<std::vector<Arc>> &lists) {
+        ChEdges e;
+        e.offsets.assign(lists.size() + 1, 0);
+        for (size_t v = 0; v < lists.size(); ++v) {
+            e.offsets[v + 1] = e.offsets[v] + lists[v].size();
+        }
+        e.targets.reserve(e.offsets.back());
+        e.middles.reserve(e.offsets.back());
+        e.weights.reserve(e.offsets.back());
+        for (const auto &arcs: lists) {
+            for (const Arc &a: arcs) {
+                e.targets.push_back(a.to);
+                e.middles.push_back(a.middle);
+                e.weights.push_back(a.w);
+            }
+        }
+        return e;
+    }
+
+    void write_section(std::ofstream &out, const void *data, size_t bytes) {
+        static const char zeros[8] = {};
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+        out.write(zeros, static_cast<std::streamsize>(align8(bytes) - bytes));
+    }
+
+    void read_section(std::ifstream &in, void *data, size_t bytes) {
+        char pad[8];
+        in.read(static_cast<char *>(data), static_cast<std::streamsize>(bytes));
+        in.read(pad, static_cast<std::streamsize>(align8(bytes) - bytes));
+    }
+
+    void write_edges(std::ofstream &out, const ChEdges &e) {
+        write_section(out, e.offsets.data(), e.offsets.size() * sizeof(uint64_t));
+        write_section(out, e.targets.data(), e.targets.size() * sizeof(int));
+        write_section(out, e.middles.data(), e.middles.size() * sizeof(int));
+        write_section(out, e.weights.data(), e.weights.size() * sizeof(uint64_t));
+    }
+
+    void read_edges(std::ifstream &in, ChEdges &e, size_t n, size_t m) {
+        e.offsets.resize(n + 1);
+        e.targets.resize(m);
+        e.middles.resize(m);
+        e.weights.resize(m);
+        read_section(in, e.offsets.data(), e.offsets.size() * sizeof(uint64_t));
+        read_section(in, e.targets.data(), m * sizeof(int));
+        read_section(in, e.middles.data(), m * sizeof(int));
+        read_section(in, e.weights.data(), m * sizeof(uint64_t));
+    }
+
+    bool edges_valid(const ChEdges &e, size_t n) {
+        if (e.offsets[0] != 0 || e.offsets[n] != e.targets.size()) {
+            return false;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (e.offsets[v] > e.offsets[v + 1]) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < e.targets.size(); ++i) {
+            if (e.targets[i] < 0 || static_cast<size_t>(e.targets[i]) >= n || e.middles[i] < -1 ||
+                e.middles[i] >= static_cast<int>(n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}// namespace
+
+ContractionHierarchy ContractionHierarchy::build(const CsrGraph &g, uint64_t core_degree) {
+    ContractionHierarchy ch;
+    ch.m_ = g.edge_count();
+    ch.max_weight_ = g.max_weight();
+
+    std::vector<std::vector<Arc>> up, down;
+    ChBuilder(g).run(core_degree, ch.rank_, up, down);
+    ch.up_ = to_csr(up);
+    ch.down_ = to_csr(down);
+    return ch;
+}
+
+std::vector<int> ContractionHierarchy::order() const {
+    std::vector<int> vertices(rank_.size());
+    for (size_t v = 0; v < rank_.size(); ++v) {
+        vertices[rank_.size() - 1 - rank_[v]] = static_cast<int>(v);
+    }
+    return vertices;
+}
+
+size_t ContractionHierarchy::shortcut_count() const {
+    return std::count_if(up_.middles.begin(), up_.middles.end(), [](int m) { return m != -1; }) +
+           std::count_if(down_.middles.begin(), down_.middles.end(), [](int m) { return m != -1; });
+}
+
+int ContractionHierarchy::middle_of(const ChEdges &edges, int at, int target, uint64_t &weight) const {
+    for (uint64_t e = edges.offsets[at]; e < edges.offsets[at + 1]; ++e) {
+        if (edges.targets[e] == target) {
+            weight = edges.weights[e];
+            return edges.middles[e];
+        }
+    }
+    throw std::runtime_error("Corrupted hierarchy: missing shortcut half");
+}
+
+void ContractionHierarchy::unpack(int u, int v, int middle, uint64_t weight,
+                                  std::vector<std::pair<int, uint64_t>> &path) const {
+    // Стек вместо рекурсии: глубина вложенности shortcut-ов не ограничена
+    class Part {
+    public:
+        int from;
+        int to;
+        int middle;
+        uint64_t w;
+    };
+    std::vector<Part> stack = {{u, v, middle, weight}};
+    while (!stack.empty()) {
+        Part p = stack.back();
+        stack.pop_back();
+        if (p.middle == -1) {
+            path.emplace_back(p.to, p.w);
+            continue;
+        }
+        // from -> middle лежит в down у middle, middle -> to — в up у middle
+        uint64_t w1 = 0, w2 = 0;
+        int m1 = middle_of(down_, p.middle, p.from, w1);
+        int m2 = middle_of(up_, p.middle, p.to, w2);
+        stack.push_back({p.middle, p.to, m2, w2});
+        stack.push_back({p.from, p.middle, m1, w1});
+    }
+}
+
+void ContractionHierarchy::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create hierarchy file: " + path);
+    }
+
+    ChHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = sizeof(ChHeader);
+    h.vertices = size();
+    h.edges = m_;
+    h.max_weight = max_weight_;
+    h.up_edges = up_.targets.size();
+    h.down_edges = down_.targets.size();
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    write_section(out, rank_.data(), rank_.size() * sizeof(int));
+    write_edges(out, up_);
+    write_edges(out, down_);
+
+    if (!out) {
+        throw std::runtime_error("Failed to write hierarchy file: " + path);
+    }
+}
+
+ContractionHierarchy ContractionHierarchy::load(const std::string &path, const CsrGraph &g) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open hierarchy file: " + path);
+    }
+
+    ChHeader h{};
+    in.read(reinterpret_cast<char *>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a hierarchy file: " + path);
+    }
+    if (h.version != VERSION || h.header_size != sizeof(ChHeader)) {
+        throw std::runtime_error("Unsupported hierarchy version " + std::to_string(h.version) + ": " + path);
+    }
+    if (h.vertices != g.size() || h.edges != g.edge_count() || h.max_weight != g.max_weight()) {
+        throw std::runtime_error("Hierarchy file was built for another graph: " + path);
+    }
+    // Каждое ребро иерархии занимает не меньше 16 байт файла
+    in.seekg(0, std::ios::end);
+    const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(sizeof(ChHeader));
+    if (h.up_edges > file_size / 16 || h.down_edges > file_size / 16) {
+        throw std::runtime_error("Hierarchy size does not match its header: " + path);
+    }
+
+    const size_t n = h.vertices;
+    ContractionHierarchy ch;
+    ch.m_ = h.edges;
+    ch.max_weight_ = static_cast<uint32_t>(h.max_weight);
+    ch.rank_.resize(n);
+    read_section(in, ch.rank_.data(), n * sizeof(int));
+    read_edges(in, ch.up_, n, h.up_edges);
+    read_edges(in, ch.down_, n, h.down_edges);
+    if (!in || in.peek() != std::char_traits<char>::eof()) {
+        throw std::runtime_error("Hierarchy size does not match its header: " + path);
+    }
+    if (!edges_valid(ch.up_, n) || !edges_valid(ch.down_, n)) {
+        throw std::runtime_error("Corrupted hierarchy file: " + path);
+    }
+    return ch;
+}
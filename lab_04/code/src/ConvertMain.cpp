@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string>
+
+#include "Graph.h"
+#include "GraphSnapshot.h"
+#include "Timer.h"
+
+// Конвертер DOT -> бинарный снимок графа (и проверка снимка)
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.dot> <output.bin>\n";
+        return 1;
+    }
+
+    try {
+        Timer t;
+        Graph g = Graph::load_from_dot_parallel(argv[1], 0);
+        long long load_us = t.us();
+
+        t.reset();
+        g.save_binary(argv[2]);
+        long long save_us = t.us();
+
+        t.reset();
+        GraphSnapshot snap = GraphSnapshot::open(argv[2], true);
+        long long open_us = t.us();
+
+        std::cout << "Вершин: " << snap.size() << ", дуг: " << snap.csr().edge_count() << "\n"
+                  << "Разбор DOT: " << load_us << " us, запись: " << save_us << " us, "
+                  << "открытие с проверкой суммы: " << open_us << " us\n";
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "CsrGraph.h"
+#include "Graph.h"
+
+#include <algorithm>
+
+CsrGraph::CsrGraph(const Graph &g) {
+    const size_t n = g.adj.size();
+
+    offsets_.resize(n + 1);
+    offsets_[0] = 0;
+    for (size_t u = 0; u < n; ++u) {
+        offsets_[u + 1] = offsets_[u] + g.adj[u].size();
+    }
+
+    targets_.resize(offsets_[n]);
+    weights_.resize(offsets_[n]);
+
+    uint64_t e = 0;
+    for (size_t u = 0; u < n; ++u) {
+        for (auto [v, w]: g.adj[u]) {
+            targets_[e] = v;
+            weights_[e] = w;
+            max_w_ = std::max(max_w_, w);
+            ++e;
+        }
+    }
+
+    n_ = n;
+    m_ = offsets_[n];
+    off_ = offsets_.data();
+    to_ = targets_.data();
+    w_ = weights_.data();
+}
+
+CsrGraph CsrGraph::reversed() const {
+    CsrGraph r;
+    r.offsets_.assign(n_ + 1, 0);
+    for (size_t e = 0; e < m_; ++e) {
+        ++r.offsets_[to_[e] + 1];
+    }
+    for (size_t v = 0; v < n_; ++v) {
+        r.offsets_[v + 1] += r.offsets_[v];
+    }
+
+    // Подсчётом по концам дуг; порядок входящих дуг — по возрастанию начала
+    r.targets_.resize(m_);
+    r.weights_.resize(m_);
+    std::vector<uint64_t> pos(r.offsets_.begin(), r.offsets_.end() - 1);
+    for (size_t u = 0; u < n_; ++u) {
+        for (uint64_t e = off_[u]; e < off_[u + 1]; ++e) {
+            uint64_t at = pos[to_[e]]++;
+            r.targets_[at] = static_cast<int>(u);
+            r.weights_[at] = w_[e];
+        }
+    }
+
+    r.n_ = n_;
+    r.m_ = m_;
+    r.max_w_ = max_w_;
+    r.off_ = r.offsets_.data();
+    r.to_ = r.targets_.data();
+    r.w_ = r.weights_.data();
+    return r;
+}
+
+CsrGraph CsrGraph::permuted(const std::vector<int> &order) const {
+    std::vector<int> rank(n_);
+    for (size_t i = 0; i < n_; ++i) {
+        rank[order[i]] = static_cast<int>(i);
+    }
+
+    CsrGraph r;
+    r.offsets_.resize(n_ + 1);
+    r.offsets_[0] = 0;
+    for (size_t i = 0; i < n_; ++i) {
+        r.offsets_[i + 1] = r.offsets_[i] + (off_[order[i] + 1] - off_[order[i]]);
+    }
+
+    r.targets_.resize(m_);
+    r.weights_.resize(m_);
+    std::vector<std::pair<int, uint32_t>> arcs;
+    for (size_t i = 0; i < n_; ++i) {
+        const int u = order[i];
+        arcs.clear();
+        for (uint64_t e = off_[u]; e < off_[u + 1]; ++e) {
+            arcs.emplace_back(rank[to_[e]], w_[e]);
+        }
+        std::sort(arcs.begin(), arcs.end());
+        uint64_t at = r.offsets_[i];
+        for (auto [v, w]: arcs) {
+            r.targets_[at] = v;
+            r.weights_[at] = w;
+            ++at;
+        }
+    }
+
+    r.n_ = n_;
+    r.m_ = m_;
+    r.max_w_ = max_w_;
+    r.off_ = r.offsets_.data();
+    r.to_ = r.targets_.data();
+    r.w_ = r.weights_.data();
+    return r;
+}
+
+CsrGraph::CsrGraph(std::shared_ptr<const void> owner, size_t n, size_t m,
+                   const uint64_t *offsets, const int *targets, const uint32_t *weights,
+                   uint32_t max_weight)
+    : owner_(std::move(owner)), n_(n), m_(m), max_w_(max_weight), off_(offsets), to_(targets), w_(weights) {}
@@ -0,0 +1,93 @@
+#include "DijkstraAlt.h"
+#include "DijkstraHeap.h"
+#include "IndexedHeap.h"
+
+DijkstraAlt::DijkstraAlt(const CsrGraph &g, const Landmarks &landmarks, int start)
+    : g_(g), lm_(landmarks), start_(start) {}
+
+void DijkstraAlt::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+DijkstraResult DijkstraAlt::run() {
+    if (targets_.empty()) {
+        return DijkstraHeap(g_, start_).run();
+    }
+
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
+    const uint64_t INF = Config::INF;
+
+    DijkstraResult res;
+    res.dist.assign(n, INF);
+    res.parent.assign(n, -1);
+    res.dist[start_] = 0;
+
+    // Рабочие массивы запроса; между целями сбрасываются только затронутые вершины
+    std::vector<uint64_t> g(n, INF);
+    std::vector<uint64_t> h(n, INF);
+    std::vector<int> parent(n, -1);
+    std::vector<char> has_h(n, 0);
+    std::vector<int> touched;
+    IndexedDaryHeap<Config::HEAP_ARITY> heap(n);
+
+    for (int target: targets_) {
+        if (res.dist[target] != INF) {
+            continue;
+        }
+
+        auto estimate = [&](int v) {
+            if (!has_h[v]) {
+                has_h[v] = 1;
+                h[v] = lm_.lower_bound(v, target);
+                touched.push_back(v);
+            }
+            return h[v];
+        };
+
+        if (estimate(start_) != INF) {
+            g[start_] = 0;
+            heap.push_or_decrease(start_, h[start_]);
+        }
+
+        while (!heap.empty()) {
+            auto [u, f] = heap.pop();
+            (void) f;
+            ++res.settled;
+            // Извлечённая вершина окончательна; уже записанный parent не меняется
+            if (res.dist[u] == INF) {
+                res.dist[u] = g[u];
+                res.parent[u] = parent[u];
+            }
+            if (u == target) {
+                break;
+            }
+            for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                int v = to[e];
+                uint64_t ng = g[u] + wt[e];
+                if (ng < g[v]) {
+                    uint64_t hv = estimate(v);
+                    if (hv == INF) {
+                        continue;
+                    }
+                    g[v] = ng;
+                    parent[v] = u;
+                    heap.push_or_decrease(v, ng + hv);
+                }
+            }
+        }
+
+        for (int v: touched) {
+            g[v] = INF;
+            h[v] = INF;
+            parent[v] = -1;
+            has_h[v] = 0;
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    return res;
+}
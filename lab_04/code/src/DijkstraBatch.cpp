@@ -0,0 +1,154 @@
+#include "DijkstraBatch.h"
+#include "Graph.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    constexpr int LANES = Config::BATCH_LANES;
+    constexpr uint64_t NO_KEY = UINT64_MAX;
+
+#ifdef SIMD_VECTOR_EXT
+    // Расстояния вершины до источников группы (векторное расширение GCC):
+    // сложение, сравнение и выбор идут по всем дорожкам одной инструкцией
+    typedef uint64_t Lanes __attribute__((vector_size(sizeof(uint64_t) * LANES)));
+    // Родители группы: маска улучшения сужается до 32 бит и выбирает u в улучшенных дорожках
+    typedef int32_t ParentLanes __attribute__((vector_size(sizeof(int32_t) * LANES)));
+#endif
+
+    using Item = std::pair<uint64_t, int>;
+
+    // Ядро релаксации встраивается в каждый клон SIMD_CLONES
+    SIMD_CLONES
+    void search_group(const CsrGraph &g, const int *sources, int count, std::vector<uint64_t> &dist,
+                      std::vector<int32_t> *parent) {
+        const int n = static_cast<int>(g.size());
+        const uint64_t *off = g.offsets();
+        const int *to = g.targets();
+        const uint32_t *wt = g.weights();
+
+        // Строки лежат в обычном массиве uint64_t: std::vector<Lanes> теряет
+        // выравнивание типа (атрибут в аргументе шаблона игнорируется), поэтому
+        // строки читаются и пишутся через memcpy — невыровненными векторными командами.
+        // Дорожки без источника остаются INF: INF + w никогда не улучшает
+        dist.assign(static_cast<size_t>(n) * LANES, Config::INF);
+        if (parent) {
+            parent->assign(static_cast<size_t>(n) * LANES, -1);
+        }
+        std::vector<uint64_t> queued(n, NO_KEY);// ключ актуальной записи вершины в очереди
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+        for (int k = 0; k < count; ++k) {
+            dist[static_cast<size_t>(sources[k]) * LANES + k] = 0;
+            if (queued[sources[k]] != 0) {
+                queued[sources[k]] = 0;
+                pq.push({0, sources[k]});
+            }
+        }
+
+        while (!pq.empty()) {
+            auto [key, u] = pq.top();
+            pq.pop();
+            if (key != queued[u]) {
+                continue;
+            }
+            queued[u] = NO_KEY;
+
+#ifdef SIMD_VECTOR_EXT
+            Lanes du;
+#else
+            uint64_t du[LANES];
+#endif
+            std::memcpy(&du, &dist[static_cast<size_t>(u) * LANES], sizeof(du));
+            for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                const int v = to[e];
+                uint64_t *row = &dist[static_cast<size_t>(v) * LANES];
+#ifdef SIMD_VECTOR_EXT
+                Lanes dv;
+                std::memcpy(&dv, row, sizeof(dv));
+                const Lanes nd = du + static_cast<uint64_t>(wt[e]);
+                const auto better = nd < dv;
+                dv = better ? nd : dv;
+                std::memcpy(row, &dv, sizeof(dv));
+
+                // Ключ — наименьшее улучшенное расстояние (горизонтальный min)
+                const Lanes improved = better ? nd : Lanes{} + NO_KEY;
+                uint64_t next = NO_KEY;
+                for (int k = 0; k < LANES; ++k) {
+                    next = std::min(next, static_cast<uint64_t>(improved[k]));
+                }
+                if (parent && next != NO_KEY) {
+                    int32_t *prow = &(*parent)[static_cast<size_t>(v) * LANES];
+                    ParentLanes pv;
+                    std::memcpy(&pv, prow, sizeof(pv));
+                    pv = __builtin_convertvector(better, ParentLanes) ? ParentLanes{} + u : pv;
+                    std::memcpy(prow, &pv, sizeof(pv));
+                }
+#else
+                int32_t *prow = parent ? &(*parent)[static_cast<size_t>(v) * LANES] : nullptr;
+                uint64_t next = NO_KEY;
+                for (int k = 0; k < LANES; ++k) {
+                    const uint64_t nd = du[k] + wt[e];
+                    if (nd < row[k]) {
+                        row[k] = nd;
+                        next = std::min(next, nd);
+                        if (prow) {
+                            prow[k] = u;
+                        }
+                    }
+                }
+#endif
+                if (next < queued[v]) {
+                    queued[v] = next;
+                    pq.push({next, v});
+                }
+            }
+        }
+    }
+}// namespace
+
+DijkstraBatch::DijkstraBatch(const Graph &g, std::vector<int> sources)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), sources_(std::move(sources)) {}
+
+DijkstraBatch::DijkstraBatch(const CsrGraph &g, std::vector<int> sources)
+    : g_(g), sources_(std::move(sources)) {}
+
+void DijkstraBatch::set_record_parents(bool record) {
+    record_parents_ = record;
+}
+
+std::vector<DijkstraResult> DijkstraBatch::run() {
+    const int n = static_cast<int>(g_.size());
+    for (int s: sources_) {
+        if (s < 0 || s >= n) {
+            throw std::invalid_argument("Batch source out of range: " + std::to_string(s));
+        }
+    }
+
+    std::vector<DijkstraResult> results(sources_.size());
+    std::vector<uint64_t> dist;
+    std::vector<int32_t> parent;
+    for (size_t first = 0; first < sources_.size(); first += LANES) {
+        const int count = static_cast<int>(std::min<size_t>(LANES, sources_.size() - first));
+        search_group(g_, sources_.data() + first, count, dist, record_parents_ ? &parent : nullptr);
+
+        for (int k = 0; k < count; ++k) {
+            DijkstraResult &res = results[first + k];
+            res.dist.resize(n);
+            res.parent.assign(n, -1);
+            for (int v = 0; v < n; ++v) {
+                const size_t at = static_cast<size_t>(v) * LANES + k;
+                res.dist[v] = dist[at];
+                res.settled += res.dist[v] < Config::INF;
+                if (record_parents_) {
+                    res.parent[v] = parent[at];
+                }
+            }
+        }
+    }
+    return results;
+}
@@ -0,0 +1,138 @@
+#include "DijkstraBidir.h"
+#include "DijkstraHeap.h"
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+#include <algorithm>
+
+namespace {
+    // Состояние поиска в одном направлении; между запросами сбрасываются
+    // только затронутые вершины
+    class SearchSide {
+    public:
+        explicit SearchSide(int n) : dist(n, Config::INF), link(n, -1), heap(n) {}
+
+        std::vector<uint64_t> dist;
+        std::vector<int> link;// parent для прямого поиска, следующая вершина пути для обратного
+        std::vector<int> touched;
+        IndexedDaryHeap<Config::HEAP_ARITY> heap;
+
+        void reach(int v, uint64_t d, int from) {
+            if (dist[v] == Config::INF) {
+                touched.push_back(v);
+            }
+            dist[v] = d;
+            link[v] = from;
+            heap.push_or_decrease(v, d);
+        }
+
+        void reset() {
+            for (int v: touched) {
+                dist[v] = Config::INF;
+                link[v] = -1;
+            }
+            touched.clear();
+            heap.clear();
+        }
+    };
+}// namespace
+
+DijkstraBidirectional::DijkstraBidirectional(const Graph &g, int start)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start) {}
+
+DijkstraBidirectional::DijkstraBidirectional(const CsrGraph &g, int start)
+    : g_(g), start_(start) {}
+
+void DijkstraBidirectional::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+void DijkstraBidirectional::prepare() {
+    if (!reverse_) {
+        reverse_ = std::make_unique<CsrGraph>(g_.reversed());
+    }
+}
+
+DijkstraResult DijkstraBidirectional::run() {
+    if (targets_.empty()) {
+        return DijkstraHeap(g_, start_).run();
+    }
+    prepare();
+
+    const int n = static_cast<int>(g_.size());
+    const CsrGraph *graphs[2] = {&g_, reverse_.get()};
+
+    DijkstraResult res;
+    res.dist.assign(n, Config::INF);
+    res.parent.assign(n, -1);
+    res.dist[start_] = 0;
+
+    SearchSide sides[2] = {SearchSide(n), SearchSide(n)};
+    std::vector<int> path;
+
+    for (int target: targets_) {
+        if (res.dist[target] != Config::INF && target != start_) {
+            continue;
+        }
+        sides[0].reach(start_, 0, -1);
+        sides[1].reach(target, 0, -1);
+        uint64_t mu = start_ == target ? 0 : Config::INF;
+        int meet = start_ == target ? start_ : -1;
+
+        while (!sides[0].heap.empty() && !sides[1].heap.empty()) {
+            if (sides[0].heap.top_key() + sides[1].heap.top_key() >= mu) {
+                break;
+            }
+            // Расширяется направление с меньшим фронтом
+            const int dir = sides[0].heap.size() <= sides[1].heap.size() ? 0 : 1;
+            SearchSide &self = sides[dir];
+            const SearchSide &other = sides[1 - dir];
+            const uint64_t *off = graphs[dir]->offsets();
+            const int *to = graphs[dir]->targets();
+            const uint32_t *wt = graphs[dir]->weights();
+
+            auto [u, d] = self.heap.pop();
+            ++res.settled;
+            for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                int v = to[e];
+                uint64_t nd = d + wt[e];
+                if (nd < self.dist[v]) {
+                    self.reach(v, nd, u);
+                    if (other.dist[v] != Config::INF && nd + other.dist[v] < mu) {
+                        mu = nd + other.dist[v];
+                        meet = v;
+                    }
+                }
+            }
+        }
+
+        if (meet != -1) {
+            // Путь start -> meet по прямым parent, meet -> target по обратным ссылкам
+            path.clear();
+            for (int v = meet; v != -1; v = sides[0].link[v]) {
+                path.push_back(v);
+            }
+            std::reverse(path.begin(), path.end());
+            const size_t meet_at = path.size() - 1;
+            for (int v = sides[1].link[meet]; v != -1; v = sides[1].link[v]) {
+                path.push_back(v);
+            }
+
+            // Уже записанный parent не меняется: он тоже задаёт кратчайший путь,
+            // а так parent остаётся деревом без циклов
+            for (size_t i = 1; i < path.size(); ++i) {
+                int v = path[i];
+                uint64_t dv = i <= meet_at ? sides[0].dist[v] : mu - sides[1].dist[v];
+                res.dist[v] = std::min(res.dist[v], dv);
+                if (res.parent[v] == -1) {
+                    res.parent[v] = path[i - 1];
+                }
+            }
+        }
+
+        sides[0].reset();
+        sides[1].reset();
+    }
+
+    return res;
+}
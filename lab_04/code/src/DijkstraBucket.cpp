@@ -0,0 +1,118 @@
+#include "DijkstraBucket.h"
+#include "Graph.h"
+#include "RadixHeap.h"
+#include "TargetSet.h"
+
+#include <vector>
+
+namespace {
+    DijkstraBucket::Strategy resolve(DijkstraBucket::Strategy s, const CsrGraph &g) {
+        if (s != DijkstraBucket::Strategy::Auto) {
+            return s;
+        }
+        return g.max_weight() <= Config::DIAL_MAX_WEIGHT ? DijkstraBucket::Strategy::Dial
+                                                         : DijkstraBucket::Strategy::Radix;
+    }
+}// namespace
+
+DijkstraBucket::DijkstraBucket(const Graph &g, int start, Strategy strategy)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start), strategy_(resolve(strategy, *own_)) {}
+
+DijkstraBucket::DijkstraBucket(const CsrGraph &g, int start, Strategy strategy)
+    : g_(g), start_(start), strategy_(resolve(strategy, g)) {}
+
+void DijkstraBucket::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+DijkstraResult DijkstraBucket::run() {
+    return strategy_ == Strategy::Dial ? run_dial() : run_radix();
+}
+
+DijkstraResult DijkstraBucket::run_dial() {
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
+
+    std::vector<uint64_t> dist(n, Config::INF);
+    std::vector<int> parent(n, -1);
+
+    // Все ключи в очереди лежат в [cur, cur + C], поэтому хватает C + 1 корзин.
+    // Устаревшие записи не удаляются, а пропускаются при извлечении.
+    const size_t nb = static_cast<size_t>(g_.max_weight()) + 1;
+    std::vector<std::vector<int>> buckets(nb);
+    size_t queued = 1;
+    TargetSet left(targets_);
+    uint64_t settled = 0;
+    bool finished = false;
+    dist[start_] = 0;
+    buckets[0].push_back(start_);
+
+    for (uint64_t cur = 0; queued > 0 && !finished; ++cur) {
+        auto &b = buckets[cur % nb];
+        while (!b.empty()) {
+            int u = b.back();
+            b.pop_back();
+            --queued;
+            if (dist[u] != cur) {
+                continue;
+            }
+            ++settled;
+            if (left.settle(u)) {
+                finished = true;
+                break;
+            }
+            for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                int v = to[e];
+                uint64_t nd = cur + wt[e];
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    buckets[nd % nb].push_back(v);
+                    ++queued;
+                }
+            }
+        }
+    }
+
+    return {std::move(dist), std::move(parent), settled};
+}
+
+DijkstraResult DijkstraBucket::run_radix() {
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
+
+    std::vector<uint64_t> dist(n, Config::INF);
+    std::vector<int> parent(n, -1);
+
+    RadixHeap heap;
+    TargetSet left(targets_);
+    uint64_t settled = 0;
+    dist[start_] = 0;
+    heap.push(0, start_);
+
+    while (!heap.empty()) {
+        auto [u, d] = heap.pop();
+        if (d != dist[u]) {
+            continue;
+        }
+        ++settled;
+        if (left.settle(u)) {
+            break;
+        }
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            int v = to[e];
+            uint64_t nd = d + wt[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                heap.push(nd, v);
+            }
+        }
+    }
+
+    return {std::move(dist), std::move(parent), settled};
+}
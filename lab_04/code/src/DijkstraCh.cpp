@@ -0,0 +1,139 @@
+#include "DijkstraCh.h"
+#include "IndexedHeap.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    class UpwardSide {
+    public:
+        explicit UpwardSide(int n) : dist(n, Config::INF), parent(n, -1), middle(n, -1), heap(n) {}
+
+        std::vector<uint64_t> dist;
+        std::vector<int> parent;
+        std::vector<int> middle;// середина ребра иерархии, по которому вершина достигнута
+        std::vector<int> touched;
+        IndexedDaryHeap<Config::HEAP_ARITY> heap;
+
+        void reach(int v, uint64_t d, int from, int mid) {
+            if (dist[v] == Config::INF) {
+                touched.push_back(v);
+            }
+            dist[v] = d;
+            parent[v] = from;
+            middle[v] = mid;
+            heap.push_or_decrease(v, d);
+        }
+
+        void reset() {
+            for (int v: touched) {
+                dist[v] = Config::INF;
+                parent[v] = -1;
+                middle[v] = -1;
+            }
+            touched.clear();
+            heap.clear();
+        }
+    };
+}// namespace
+
+DijkstraCh::DijkstraCh(const ContractionHierarchy &ch, int start)
+    : ch_(ch), start_(start) {}
+
+void DijkstraCh::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+DijkstraResult DijkstraCh::run() {
+    if (targets_.empty()) {
+        throw std::invalid_argument("Contraction hierarchy query needs at least one target");
+    }
+
+    const int n = static_cast<int>(ch_.size());
+    const ChEdges *edges[2] = {&ch_.up(), &ch_.down()};
+
+    DijkstraResult res;
+    res.dist.assign(n, Config::INF);
+    res.parent.assign(n, -1);
+    res.dist[start_] = 0;
+
+    UpwardSide sides[2] = {UpwardSide(n), UpwardSide(n)};
+    std::vector<std::pair<int, uint64_t>> path;
+
+    for (int target: targets_) {
+        if (res.dist[target] != Config::INF) {
+            continue;
+        }
+        sides[0].reach(start_, 0, -1, -1);
+        sides[1].reach(target, 0, -1, -1);
+        uint64_t mu = Config::INF;
+        int meet = -1;
+
+        while (!sides[0].heap.empty() || !sides[1].heap.empty()) {
+            int dir = sides[0].heap.empty() ? 1
+                      : sides[1].heap.empty() ? 0
+                      : (sides[0].heap.top_key() <= sides[1].heap.top_key() ? 0 : 1);
+            UpwardSide &self = sides[dir];
+            const UpwardSide &other = sides[1 - dir];
+            if (self.heap.top_key() >= mu) {
+                self.heap.clear();
+                continue;
+            }
+
+            auto [u, d] = self.heap.pop();
+            ++res.settled;
+            if (other.dist[u] != Config::INF && d + other.dist[u] < mu) {
+                mu = d + other.dist[u];
+                meet = u;
+            }
+            const ChEdges &e = *edges[dir];
+            for (uint64_t i = e.offsets[u]; i < e.offsets[u + 1]; ++i) {
+                int v = e.targets[i];
+                uint64_t nd = d + e.weights[i];
+                if (nd < self.dist[v]) {
+                    self.reach(v, nd, u, e.middles[i]);
+                    if (other.dist[v] != Config::INF && nd + other.dist[v] < mu) {
+                        mu = nd + other.dist[v];
+                        meet = v;
+                    }
+                }
+            }
+        }
+
+        if (meet != -1) {
+            // Рёбра иерархии start -> meet (вперёд) и meet -> target (назад)
+            std::vector<int> chain;
+            for (int v = meet; v != -1; v = sides[0].parent[v]) {
+                chain.push_back(v);
+            }
+            std::reverse(chain.begin(), chain.end());
+
+            path.clear();
+            for (size_t i = 1; i < chain.size(); ++i) {
+                int v = chain[i];
+                ch_.unpack(chain[i - 1], v, sides[0].middle[v], sides[0].dist[v] - sides[0].dist[chain[i - 1]], path);
+            }
+            for (int v = meet; sides[1].parent[v] != -1; v = sides[1].parent[v]) {
+                int next = sides[1].parent[v];
+                ch_.unpack(v, next, sides[1].middle[v], sides[1].dist[v] - sides[1].dist[next], path);
+            }
+
+            // Уже записанный parent не меняется, поэтому parent остаётся деревом
+            int prev = start_;
+            uint64_t d = 0;
+            for (auto [v, w]: path) {
+                d += w;
+                res.dist[v] = std::min(res.dist[v], d);
+                if (res.parent[v] == -1 && v != start_) {
+                    res.parent[v] = prev;
+                }
+                prev = v;
+            }
+        }
+
+        sides[0].reset();
+        sides[1].reset();
+    }
+
+    return res;
+}
@@ -0,0 +1,304 @@
+#include "DijkstraDelta.h"
+#include "Graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <random>
+#include <thread>
+
+namespace {
+    // Вершины фазы раздаются потокам кусками через общий счётчик
+    constexpr size_t CHUNK = 64;
+
+    class Entry {
+    public:
+        int v;
+        uint64_t dist;
+    };
+
+    // Корзины одного потока: кольцо на окно [cur, cur + nb) и записи дальше окна
+    class Buckets {
+    public:
+        std::vector<std::vector<Entry>> ring;
+        std::vector<Entry> overflow;
+        uint64_t overflow_min = UINT64_MAX;// наименьший номер корзины в overflow
+    };
+
+    class SplitArcs {
+    public:
+        std::vector<uint64_t> offsets;
+        std::vector<int> targets;
+        std::vector<uint32_t> weights;
+    };
+}// namespace
+
+DijkstraDelta::DijkstraDelta(const Graph &g, int start, int threads, uint64_t delta)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start), threads_(threads),
+      delta_(delta ? delta : choose_delta(*own_)) {}
+
+DijkstraDelta::DijkstraDelta(const CsrGraph &g, int start, int threads, uint64_t delta)
+    : g_(g), start_(start), threads_(threads), delta_(delta ? delta : choose_delta(g)) {}
+
+void DijkstraDelta::set_threads(int t) {
+    threads_ = t;
+}
+
+void DijkstraDelta::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+void DijkstraDelta::prepare() {
+    if (split_) {
+        return;
+    }
+    const size_t n = g_.size();
+    const size_t m = g_.edge_count();
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
+
+    auto arcs = std::make_shared<SplitArcs>();
+    arcs->offsets.assign(off, off + n + 1);
+    arcs->targets.resize(m);
+    arcs->weights.resize(m);
+    light_end_.resize(n);
+    for (size_t v = 0; v < n; ++v) {
+        uint64_t lo = off[v], hi = off[v + 1];
+        for (uint64_t e = off[v]; e < off[v + 1]; ++e) {
+            uint64_t at = wt[e] <= delta_ ? lo++ : --hi;
+            arcs->targets[at] = to[e];
+            arcs->weights[at] = wt[e];
+        }
+        light_end_[v] = lo;
+    }
+    const uint64_t *offsets = arcs->offsets.data();
+    const int *targets = arcs->targets.data();
+    const uint32_t *weights = arcs->weights.data();
+    split_ = std::make_unique<CsrGraph>(std::move(arcs), n, m, offsets, targets, weights, g_.max_weight());
+}
+
+uint64_t DijkstraDelta::choose_delta(const CsrGraph &g) {
+    const size_t n = g.size();
+    const size_t m = g.edge_count();
+    if (m == 0) {
+        return 1;
+    }
+
+    const uint32_t *wt = g.weights();
+    const size_t k = std::min<size_t>(m, Config::DELTA_WEIGHT_SAMPLE);
+    std::vector<uint32_t> sample;
+    sample.reserve(k);
+    if (k == m) {
+        sample.assign(wt, wt + m);
+    } else {
+        std::mt19937_64 rng(m);
+        std::uniform_int_distribution<size_t> pick(0, m - 1);
+        for (size_t i = 0; i < k; ++i) {
+            sample.push_back(wt[pick(rng)]);
+        }
+    }
+
+    const double avg_degree = static_cast<double>(m) / static_cast<double>(n);
+    const double q = std::min(1.0, Config::DELTA_LIGHT_EDGES / avg_degree);
+    const size_t at = std::min(k - 1, static_cast<size_t>(q * static_cast<double>(k)));
+    std::nth_element(sample.begin(), sample.begin() + static_cast<std::ptrdiff_t>(at), sample.end());
+    return std::max<uint64_t>(1, sample[at]);
+}
+
+DijkstraParResult DijkstraDelta::run() {
+    QueryWorkspace ws;
+    QueryView r = run(ws);
+    DijkstraParResult res;
+    res.dist = r.dist_vector();
+    res.parent = r.parent_vector();
+    res.settled = r.settled();
+    return res;
+}
+
+QueryView DijkstraDelta::run(QueryWorkspace &ws) {
+    int threads = threads_;
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    prepare();
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = split_->offsets();
+    const int *to = split_->targets();
+    const uint32_t *wt = split_->weights();
+    const uint64_t *light_end = light_end_.data();
+    const uint64_t delta = delta_;
+    // Живые записи лежат в корзинах [cur, cur + max_w / Δ + 1]; кольцо
+    // ограничено, чтобы одна тяжёлая дуга не раздувала его до max_w / Δ корзин
+    const size_t nb = static_cast<size_t>(
+            std::min<uint64_t>(g_.max_weight() / delta + 2, Config::DELTA_RING_BUCKETS));
+
+    ws.begin(n);
+
+    // Корзины у каждого потока свои: запись без синхронизации, слияние — между фазами.
+    // Запись (v, d) актуальна, пока d равно текущему dist[v]: каждое
+    // уменьшение расстояния порождает ровно одну запись
+    std::vector<Buckets> local(threads);
+    for (Buckets &b: local) {
+        b.ring.resize(nb);
+    }
+
+    enum class Step { Light, Heavy, Done };
+    Step step = Step::Light;
+    uint64_t cur = 0;
+    std::vector<Entry> frontier;
+    std::vector<int> removed;// вершины, извлечённые из текущей корзины
+    uint64_t settled = 0;
+    std::atomic<size_t> next{0};
+
+    auto gather = [&]() {
+        frontier.clear();
+        for (Buckets &b: local) {
+            auto &slot = b.ring[cur % nb];
+            for (const Entry &e: slot) {
+                if (e.dist == ws.load_dist(e.v)) {
+                    frontier.push_back(e);
+                    if (!ws.settled(e.v)) {
+                        ws.settle(e.v);
+                        removed.push_back(e.v);
+                    }
+                }
+            }
+            slot.clear();
+        }
+    };
+
+    // Следующая непустая корзина: ближайшая в кольце или первая из переполнения.
+    // Записи переполнения, попавшие в сдвинутое окно, переносятся в кольцо,
+    // устаревшие отбрасываются
+    auto advance = [&]() {
+        uint64_t target = UINT64_MAX;
+        for (size_t ahead = 1; ahead < nb && target == UINT64_MAX; ++ahead) {
+            for (const Buckets &b: local) {
+                if (!b.ring[(cur + ahead) % nb].empty()) {
+                    target = cur + ahead;
+                    break;
+                }
+            }
+        }
+        for (const Buckets &b: local) {
+            target = std::min(target, b.overflow_min);
+        }
+        if (target == UINT64_MAX) {
+            return false;
+        }
+        cur = target;
+
+        for (Buckets &b: local) {
+            if (b.overflow_min - cur >= nb) {
+                continue;
+            }
+            size_t kept = 0;
+            uint64_t low = UINT64_MAX;
+            for (const Entry &e: b.overflow) {
+                if (e.dist != ws.load_dist(e.v)) {
+                    continue;
+                }
+                const uint64_t bucket = e.dist / delta;
+                if (bucket - cur < nb) {
+                    b.ring[bucket % nb].push_back(e);
+                } else {
+                    b.overflow[kept++] = e;
+                    low = std::min(low, bucket);
+                }
+            }
+            b.overflow.resize(kept);
+            b.overflow_min = low;
+        }
+        return true;
+    };
+
+    // Цели окончательны, когда все они лежат в уже пройденных корзинах
+    auto targets_done = [&]() {
+        if (targets_.empty()) {
+            return false;
+        }
+        for (int t: targets_) {
+            if (ws.load_dist(t) >= cur * delta) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Между фазами (один поток): следующая лёгкая фаза той же корзины,
+    // тяжёлая фаза по извлечённым вершинам или переход к следующей корзине
+    auto plan = [&]() noexcept {
+        next.store(0, std::memory_order_relaxed);
+        if (step == Step::Light) {
+            gather();
+            if (!frontier.empty()) {
+                return;
+            }
+            if (!removed.empty()) {
+                settled += removed.size();
+                for (int v: removed) {
+                    frontier.push_back({v, ws.load_dist(v)});
+                }
+                removed.clear();
+                step = Step::Heavy;
+                return;
+            }
+        }
+        while (advance() && !targets_done()) {
+            gather();
+            if (!frontier.empty()) {
+                step = Step::Light;
+                return;
+            }
+        }
+        step = Step::Done;
+    };
+
+    std::barrier sync(threads, plan);
+
+    auto worker = [&](int tid) {
+        auto &mine = local[tid];
+        while (step != Step::Done) {
+            const bool light = step == Step::Light;
+            for (size_t lo; (lo = next.fetch_add(CHUNK, std::memory_order_relaxed)) < frontier.size();) {
+                const size_t hi = std::min(lo + CHUNK, frontier.size());
+                for (size_t i = lo; i < hi; ++i) {
+                    const auto [v, d] = frontier[i];
+                    const uint64_t first = light ? off[v] : light_end[v];
+                    const uint64_t last = light ? light_end[v] : off[v + 1];
+                    for (uint64_t e = first; e < last; ++e) {
+                        uint64_t nd = d + wt[e];
+                        if (ws.try_relax(to[e], nd, v)) {
+                            const uint64_t bucket = nd / delta;
+                            if (bucket - cur < nb) {
+                                mine.ring[bucket % nb].push_back({to[e], nd});
+                            } else {
+                                mine.overflow.push_back({to[e], nd});
+                                mine.overflow_min = std::min(mine.overflow_min, bucket);
+                            }
+                        }
+                    }
+                }
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    ws.try_relax(start_, 0, -1);
+    local[0].ring[0].push_back({start_, 0});
+    gather();
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &th: pool) {
+        th.join();
+    }
+
+    return {ws, settled};
+}
@@ -0,0 +1,181 @@
+#include "DijkstraDense.h"
+#include "Simd.h"
+#include "TargetSet.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr size_t LANES = 8;
+    // Старший бит метки — вершина окончательна; расстояния не превышают
+    // Config::INF, так что бит свободен
+    constexpr uint64_t SETTLED = uint64_t(1) << 63;
+
+#ifdef SIMD_VECTOR_EXT
+    typedef uint64_t Keys __attribute__((vector_size(sizeof(uint64_t) * LANES)));
+    typedef uint32_t Weights __attribute__((vector_size(sizeof(uint32_t) * LANES)));
+    typedef int Parents __attribute__((vector_size(sizeof(int) * LANES)));
+#endif
+
+    // Номер наименьшей метки, при равенстве — меньший номер, как у линейного
+    // выбора в DijkstraSequential. Окончательные вершины со старшим битом
+    // проигрывают любой конечной метке.
+    SIMD_CLONES
+    int argmin(const uint64_t *key, size_t len) {
+#ifdef SIMD_VECTOR_EXT
+        // Два независимых аккумулятора: цепочка сравнение-выбор не ждёт себя же
+        Keys best[2] = {Keys{} + UINT64_MAX, Keys{} + UINT64_MAX};
+        Keys idx[2] = {};
+        Keys cur = {0, 1, 2, 3, 4, 5, 6, 7};
+        size_t i = 0;
+        for (; i + 2 * LANES <= len; i += 2 * LANES) {
+            for (int j = 0; j < 2; ++j) {
+                Keys k;
+                std::memcpy(&k, key + i + j * LANES, sizeof(k));
+                const auto less = k < best[j];
+                best[j] = less ? k : best[j];
+                idx[j] = less ? cur + j * LANES : idx[j];
+            }
+            cur += 2 * LANES;
+        }
+        if (i < len) {
+            Keys k;
+            std::memcpy(&k, key + i, sizeof(k));
+            const auto less = k < best[0];
+            best[0] = less ? k : best[0];
+            idx[0] = less ? cur : idx[0];
+        }
+        uint64_t min_key = UINT64_MAX;
+        uint64_t at = 0;
+        for (int j = 0; j < 2; ++j) {
+            for (size_t k = 0; k < LANES; ++k) {
+                if (best[j][k] < min_key || (best[j][k] == min_key && idx[j][k] < at)) {
+                    min_key = best[j][k];
+                    at = idx[j][k];
+                }
+            }
+        }
+        return static_cast<int>(at);
+#else
+        uint64_t min_key = UINT64_MAX;
+        size_t at = 0;
+        for (size_t i = 0; i < len; ++i) {
+            if (key[i] < min_key) {
+                min_key = key[i];
+                at = i;
+            }
+        }
+        return static_cast<int>(at);
+#endif
+    }
+
+    // Обновление меток по строке u. Окончательную вершину v улучшить нельзя
+    // (dist(v) <= du), поэтому сравнение идёт с меткой без старшего бита, а
+    // сам бит сохраняется. Отсутствующая дуга даёт INF и не улучшает ничего.
+    SIMD_CLONES
+    void relax_row(uint64_t *key, int *parent, const uint32_t *row, size_t len, uint64_t du, int u) {
+#ifdef SIMD_VECTOR_EXT
+        for (size_t i = 0; i < len; i += LANES) {
+            Weights w;
+            std::memcpy(&w, row + i, sizeof(w));
+            const Keys wide = __builtin_convertvector(w, Keys);
+            const Keys cand = wide == DenseGraph::MISSING ? Keys{} + Config::INF : wide + du;
+
+            Keys k;
+            std::memcpy(&k, key + i, sizeof(k));
+            const auto better = cand < (k & ~SETTLED);
+            k = better ? cand : k;
+            std::memcpy(key + i, &k, sizeof(k));
+
+            if (parent) {
+                Parents p;
+                std::memcpy(&p, parent + i, sizeof(p));
+                p = __builtin_convertvector(better, Parents) ? Parents{} + u : p;
+                std::memcpy(parent + i, &p, sizeof(p));
+            }
+        }
+#else
+        for (size_t i = 0; i < len; ++i) {
+            const uint64_t cand = row[i] == DenseGraph::MISSING ? Config::INF : row[i] + du;
+            if (cand < (key[i] & ~SETTLED)) {
+                key[i] = cand;
+                if (parent) {
+                    parent[i] = u;
+                }
+            }
+        }
+#endif
+    }
+}// namespace
+
+DenseGraph::DenseGraph(const CsrGraph &g) : n_(g.size()) {
+    if (n_ > Config::DENSE_MAX_VERTICES) {
+        throw std::invalid_argument("Graph too large for the dense engine: " + std::to_string(n_) +
+                                    " vertices (max " + std::to_string(Config::DENSE_MAX_VERTICES) + ")");
+    }
+    stride_ = (n_ + LANES - 1) / LANES * LANES;
+    w_.assign(n_ * stride_, MISSING);
+
+    const uint64_t *off = g.offsets();
+    const int *to = g.targets();
+    const uint32_t *wt = g.weights();
+    for (size_t u = 0; u < n_; ++u) {
+        uint32_t *r = w_.data() + u * stride_;
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            if (wt[e] == MISSING) {
+                throw std::invalid_argument("Edge weight " + std::to_string(wt[e]) + " is reserved by the dense engine");
+            }
+            r[to[e]] = std::min(r[to[e]], wt[e]);
+        }
+    }
+}
+
+DijkstraDense::DijkstraDense(const DenseGraph &g, int start)
+    : g_(g), start_(start) {}
+
+void DijkstraDense::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+void DijkstraDense::set_record_parents(bool record) {
+    record_parents_ = record;
+}
+
+DijkstraResult DijkstraDense::run() {
+    const size_t n = g_.size();
+    const size_t stride = g_.stride();
+
+    // Дополнение строки — окончательные вершины с INF: их не выберут и не улучшат
+    std::vector<uint64_t> key(stride, Config::INF);
+    std::fill(key.begin() + static_cast<std::ptrdiff_t>(n), key.end(), Config::INF | SETTLED);
+    std::vector<int> parent(stride, -1);
+    key[start_] = 0;
+    TargetSet left(targets_);
+    uint64_t settled = 0;
+
+    while (true) {
+        const int u = argmin(key.data(), stride);
+        const uint64_t du = key[u];
+        if (du >= Config::INF) {
+            break;
+        }
+        key[u] |= SETTLED;
+        ++settled;
+        if (left.settle(u)) {
+            break;
+        }
+        relax_row(key.data(), record_parents_ ? parent.data() : nullptr, g_.row(u), stride, du, u);
+    }
+
+    DijkstraResult r;
+    r.dist.resize(n);
+    for (size_t v = 0; v < n; ++v) {
+        r.dist[v] = key[v] & ~SETTLED;
+    }
+    parent.resize(n);
+    r.parent = std::move(parent);
+    r.settled = settled;
+    return r;
+}
@@ -0,0 +1,66 @@
+#include "DijkstraHeap.h"
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "TargetSet.h"
+
+#include <stdexcept>
+#include <string>
+
+DijkstraHeap::DijkstraHeap(const Graph &g, int start, int arity)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start), arity_(arity) {}
+
+DijkstraHeap::DijkstraHeap(const CsrGraph &g, int start, int arity)
+    : g_(g), start_(start), arity_(arity) {}
+
+void DijkstraHeap::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+DijkstraResult DijkstraHeap::run() {
+    switch (arity_) {
+        case 2:
+            return run_with<2>();
+        case 4:
+            return run_with<4>();
+        case 8:
+            return run_with<8>();
+        default:
+            throw std::invalid_argument("Unsupported heap arity: " + std::to_string(arity_));
+    }
+}
+
+template<int D>
+DijkstraResult DijkstraHeap::run_with() {
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
+
+    std::vector<uint64_t> dist(n, Config::INF);
+    std::vector<int> parent(n, -1);
+
+    IndexedDaryHeap<D> heap(n);
+    TargetSet left(targets_);
+    uint64_t settled = 0;
+    dist[start_] = 0;
+    heap.push_or_decrease(start_, 0);
+
+    while (!heap.empty()) {
+        auto [u, d] = heap.pop();
+        ++settled;
+        if (left.settle(u)) {
+            break;
+        }
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            int v = to[e];
+            uint64_t nd = d + wt[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                heap.push_or_decrease(v, nd);
+            }
+        }
+    }
+
+    return {std::move(dist), std::move(parent), settled};
+}
@@ -0,0 +1,68 @@
+#include "DijkstraHub.h"
+#include "PathRecovery.h"
+
+#include <stdexcept>
+
+DijkstraHub::DijkstraHub(const HubLabels &labels, const CsrGraph &g, int start)
+    : labels_(labels), g_(g), start_(start) {}
+
+void DijkstraHub::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+void DijkstraHub::set_recover_paths(bool recover) {
+    recover_paths_ = recover;
+}
+
+void DijkstraHub::prepare() {
+    if (!reverse_) {
+        reverse_ = std::make_unique<CsrGraph>(g_.reversed());
+    }
+}
+
+DijkstraResult DijkstraHub::run() {
+    if (targets_.empty()) {
+        throw std::invalid_argument("Hub label query needs at least one target");
+    }
+
+    const int n = static_cast<int>(labels_.size());
+    DijkstraResult res;
+    res.dist.assign(n, Config::INF);
+    res.parent.assign(n, -1);
+    res.dist[start_] = 0;
+
+    // settled — число запросов к меткам
+    for (int t: targets_) {
+        if (res.dist[t] == Config::INF) {
+            res.dist[t] = labels_.distance(start_, t);
+            ++res.settled;
+        }
+    }
+    if (!recover_paths_) {
+        return res;
+    }
+
+    prepare();
+    auto dist = [&](int p) {
+        if (res.dist[p] == Config::INF) {
+            res.dist[p] = labels_.distance(start_, p);
+            ++res.settled;
+        }
+        return res.dist[p];
+    };
+    for (int t: targets_) {
+        if (t == start_ || res.dist[t] == Config::INF || res.parent[t] != -1) {
+            continue;
+        }
+        // Уже восстановленные parent не переписываются: иначе при дугах
+        // нулевого веса пути разных целей могли бы замкнуться в цикл
+        std::vector<int> path = recover_path(*reverse_, start_, t, dist);
+        for (size_t j = 1; j < path.size(); ++j) {
+            if (res.parent[path[j]] == -1) {
+                res.parent[path[j]] = path[j - 1];
+            }
+        }
+    }
+
+    return res;
+}
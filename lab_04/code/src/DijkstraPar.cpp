@@ -1,13 +1,17 @@
 #include <atomic>
 #include <condition_variable>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include "DijkstraPar.h"
 #include "Graph.h"
+#include "GraphPartition.h"
 
 namespace {
     class Node {
@@ -19,203 +23,418 @@ namespace {
         }
     };
 
+    // Ключ верхушки пустой очереди
+    constexpr uint64_t EMPTY = std::numeric_limits<uint64_t>::max();
+
+    // Одна из c * threads последовательных куч MultiQueue. top дублирует ключ
+    // верхушки, чтобы выбирать лучшую из двух очередей без блокировки
     class WorkQueue {
     public:
         std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
         std::mutex m;
-        std::atomic<int> approx_size{0};
+        std::atomic<uint64_t> top{EMPTY};
+
+        void publish_top() {
+            top.store(pq.empty() ? EMPTY : pq.top().dist, std::memory_order_relaxed);
+        }
     };
 
+    // Счётчики одного потока; выравнивание — против ложного разделения
+    class alignas(64) LocalStats {
+    public:
+        uint64_t pops = 0;
+        uint64_t stale_pops = 0;
+        uint64_t rank_samples = 0;
+        uint64_t rank_sum = 0;
+        uint64_t pushes = 0;
+        uint64_t cross_pushes = 0;
+        uint64_t locks = 0;
+        uint64_t notifications = 0;
+        uint64_t settled = 0;
+        uint64_t reexpansions = 0;
+    };
+
+    // Счётчики завершения потока: пишет только владелец, читают все при проверке покоя
+    class alignas(64) Progress {
+    public:
+        std::atomic<uint64_t> pushed{0};
+        std::atomic<uint64_t> completed{0};// извлечено и обработано (или отброшено)
+    };
+
+    // Граница [lo, hi) доли потока tid при делении n элементов на threads частей
+    size_t slice_begin(size_t n, int tid, int threads) {
+        return n * static_cast<size_t>(tid) / static_cast<size_t>(threads);
+    }
+
+    // threads <= 0 — по числу логических ядер
+    int resolve_threads(int threads) {
+        return threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
 }// namespace
 
 DijkstraParallel::DijkstraParallel(const Graph &g, int start, int threads)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start), threads_(threads) {}
+
+DijkstraParallel::DijkstraParallel(const CsrGraph &g, int start, int threads)
     : g_(g), start_(start), threads_(threads) {}
 
 void DijkstraParallel::set_threads(int t) {
     threads_ = t;
+    if (pool_) {
+        pool_->resize(resolve_threads(t));
+    }
+}
+
+void DijkstraParallel::set_pool(std::shared_ptr<WorkerPool> pool) {
+    pool_ = std::move(pool);
+}
+
+void DijkstraParallel::set_queue_factor(int c) {
+    if (c < 1) {
+        throw std::invalid_argument("MultiQueue factor must be positive");
+    }
+    queue_factor_ = c;
+}
+
+void DijkstraParallel::set_push_batch(int b) {
+    if (b < 1) {
+        throw std::invalid_argument("Push batch must be positive");
+    }
+    push_batch_ = b;
+}
+
+void DijkstraParallel::set_partition(std::shared_ptr<const GraphPartition> partition) {
+    partition_ = std::move(partition);
+}
+
+void DijkstraParallel::set_record_parents(bool record) {
+    record_parents_ = record;
+}
+
+void DijkstraParallel::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
 }
 
 DijkstraParResult DijkstraParallel::run() {
-    int threads = threads_;
-    if (threads <= 0) {
-        threads = std::max(1u, std::thread::hardware_concurrency());
+    QueryWorkspace ws;
+    QueryView r = run(ws);
+    DijkstraParResult res;
+    const size_t n = r.size();
+    res.dist.resize(n);
+    res.parent.resize(n);
+    const int parts = pool_->size();
+    pool_->run([&](int tid) {
+        for (size_t v = slice_begin(n, tid, parts); v < slice_begin(n, tid + 1, parts); ++v) {
+            res.dist[v] = r.dist(static_cast<int>(v));
+            res.parent[v] = r.parent(static_cast<int>(v));
+        }
+    });
+    res.settled = r.settled();
+    return res;
+}
+
+QueryView DijkstraParallel::run(QueryWorkspace &ws) {
+    const int threads = resolve_threads(threads_);
+    if (!pool_) {
+        pool_ = std::make_shared<WorkerPool>(threads);
     }
+    pool_->resize(threads);
 
-    const int n = static_cast<int>(g_.adj.size());
+    const int n = static_cast<int>(g_.size());
+    if (partition_ && (partition_->parts() != threads || partition_->size() != g_.size())) {
+        throw std::invalid_argument("Partition has " + std::to_string(partition_->parts()) + " parts of " +
+                                    std::to_string(partition_->size()) + " vertices, the query needs " +
+                                    std::to_string(threads) + " of " + std::to_string(n));
+    }
+    const uint64_t *off = g_.offsets();
+    const int *targets = g_.targets();
+    const uint32_t *weights = g_.weights();
     const uint64_t INF = Config::INF;
 
-    std::vector<std::atomic<uint64_t>> dist(n);
-    std::vector<std::atomic<int>> parent(n);
-    for (int i = 0; i < n; ++i) {
-        dist[i].store(INF, std::memory_order_relaxed);
-        parent[i].store(-1, std::memory_order_relaxed);
+    // Длина простого пути не больше (n - 1) * max_w: по ней выбирается упаковка
+    const uint64_t dist_bound = static_cast<uint64_t>(g_.max_weight()) * static_cast<uint64_t>(std::max(n - 1, 0));
+    ws.begin_packed(n, dist_bound, record_parents_);
+    if (ws.packed()) {
+        pool_->run([&](int tid) {
+            ws.reset(slice_begin(n, tid, threads), slice_begin(n, tid + 1, threads));
+        });
     }
 
-    std::vector<WorkQueue> queues(threads);
-    std::atomic<long long> tasks{0};
-    std::atomic<int> active{0};
-    std::condition_variable cv;
-    std::mutex cv_m;
+    const int queue_count = queue_factor_ * threads;
+    const size_t batch = static_cast<size_t>(push_batch_);
+    const GraphPartition *partition = partition_.get();
+    std::vector<WorkQueue> queues(queue_count);
+    std::vector<LocalStats> local_stats(threads);
+    std::vector<Progress> progress(threads);
+    // Буфер потока — по одному на часть-получателя (без разбиения — один)
+    const int groups = partition ? threads : 1;
+    std::vector<std::vector<std::vector<Node>>> outbox(threads, std::vector<std::vector<Node>>(groups));
+    std::mutex sleep_m;
+    std::condition_variable wake;
+    std::atomic<int> sleepers{0};
     std::atomic<bool> done{false};
 
-    auto random_thread = [threads]() {
+    // Пока хотя бы одна цель не достигнута, граница равна INF и отсечения нет.
+    // Расстояния только убывают, поэтому отсечение по устаревшей границе корректно.
+    auto target_bound = [&]() {
+        if (targets_.empty()) {
+            return INF;
+        }
+        uint64_t bound = 0;
+        for (int t: targets_) {
+            bound = std::max(bound, ws.load_dist(t));
+        }
+        return bound;
+    };
+
+    // Верх очереди — её минимум: если он не меньше границы, бесполезна вся очередь
+    auto drop_queue = [&](int idx, uint64_t bound, int tid) {
+        std::lock_guard<std::mutex> lg(queues[idx].m);
+        ++local_stats[tid].locks;
+        if (queues[idx].pq.empty() || queues[idx].pq.top().dist < bound) {
+            return;
+        }
+        uint64_t dropped = queues[idx].pq.size();
+        queues[idx].pq = {};
+        queues[idx].publish_top();
+        progress[tid].completed.fetch_add(dropped);
+    };
+
+    auto random_below = [](int k) {
         thread_local std::mt19937_64 gen{std::random_device{}() ^ ((uint64_t) std::hash<std::thread::id>{}(std::this_thread::get_id()))};
-        std::uniform_int_distribution<int> dist(0, threads - 1);
+        std::uniform_int_distribution<int> dist(0, k - 1);
         return dist(gen);
     };
+    auto random_queue = [&]() {
+        return random_below(queue_count);
+    };
+    // Случайная из c очередей потока owner
+    auto queue_of = [&](int owner) {
+        return owner * queue_factor_ + random_below(queue_factor_);
+    };
 
-    auto push_to = [&](int owner, const Node &nd) {
-        if (owner < 0 || owner >= threads) {
-            owner = 0;
+    auto any_work = [&]() {
+        for (const WorkQueue &q: queues) {
+            if (q.top.load(std::memory_order_relaxed) != EMPTY) {
+                return true;
+            }
         }
+        return false;
+    };
 
-        {
-            std::lock_guard<std::mutex> lg(queues[owner].m);
-            queues[owner].pq.push(nd);
-            queues[owner].approx_size.fetch_add(1, std::memory_order_relaxed);
+    // Буфер уходит одной пачкой в очередь, захваченную try_lock: случайную или,
+    // при разбиении, одну из очередей владельца. pushed растёт до публикации,
+    // чтобы completed никогда не обгонял pushed. Будим одного спящего, только
+    // если спящие есть
+    auto flush_group = [&](int tid, int group) {
+        std::vector<Node> &out = outbox[tid][group];
+        if (out.empty()) {
+            return;
+        }
+        LocalStats &st = local_stats[tid];
+        progress[tid].pushed.fetch_add(out.size());
+        int idx;
+        while (true) {
+            idx = partition ? queue_of(group) : random_queue();
+            WorkQueue &q = queues[idx];
+            std::unique_lock<std::mutex> lk(q.m, std::try_to_lock);
+            if (!lk.owns_lock()) {
+                continue;
+            }
+            for (const Node &nd: out) {
+                q.pq.push(nd);
+            }
+            q.publish_top();
+            break;
+        }
+        ++st.locks;
+        st.pushes += out.size();
+        if (idx / queue_factor_ != tid) {
+            st.cross_pushes += out.size();
+        }
+        out.clear();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            // Пустой захват: спящий либо ещё проверит очереди, либо уже ждёт
+            { std::lock_guard<std::mutex> lg(sleep_m); }
+            wake.notify_one();
+            ++st.notifications;
+        }
+    };
+    auto flush = [&](int tid) {
+        for (int group = 0; group < groups; ++group) {
+            flush_group(tid, group);
         }
-        tasks.fetch_add(1, std::memory_order_relaxed);
-        cv.notify_one();
     };
 
-    auto pop_local = [&](int idx, Node &out) -> bool {
-        if (queues[idx].approx_size.load(std::memory_order_relaxed) == 0) {
+    auto pop_from = [&](int idx, Node &out, std::unique_lock<std::mutex> &lk, LocalStats &st) -> bool {
+        WorkQueue &q = queues[idx];
+        if (!lk.owns_lock()) {
             return false;
         }
-
-        std::unique_lock<std::mutex> lk(queues[idx].m);
-        if (queues[idx].pq.empty()) {
-            queues[idx].approx_size.store(0, std::memory_order_relaxed);
+        ++st.locks;
+        if (q.pq.empty()) {
             return false;
         }
-
-        out = queues[idx].pq.top();
-        queues[idx].pq.pop();
-        queues[idx].approx_size.fetch_sub(1, std::memory_order_relaxed);
+        out = q.pq.top();
+        q.pq.pop();
+        q.publish_top();
         return true;
     };
 
-    auto steal_from = [&](int idx, Node &out) -> bool {
-        if (threads <= 1) {
-            return false;
-        }
-
-        int start = random_thread();
-        for (int attempt = 0; attempt < threads; ++attempt) {
-            int target = (start + attempt) % threads;
-            if (target == idx) {
-                continue;
+    // Лучшая из верхушек двух случайных очередей; при разбиении первая попытка —
+    // среди своих очередей, остальные крадут работу у других потоков. После
+    // queue_count неудачных попыток (пусто или занято) — полный обход, чтобы
+    // не пропустить единственную непустую очередь
+    auto try_pop = [&](Node &out, int &from, int tid, LocalStats &st) -> bool {
+        for (int attempt = 0; attempt < queue_count; ++attempt) {
+            const bool own = partition && attempt == 0;
+            int a = own ? queue_of(tid) : random_queue();
+            int b = own ? queue_of(tid) : random_queue();
+            if (queues[b].top.load(std::memory_order_relaxed) < queues[a].top.load(std::memory_order_relaxed)) {
+                std::swap(a, b);
             }
-
-            if (queues[target].approx_size.load(std::memory_order_relaxed) == 0) {
+            if (queues[a].top.load(std::memory_order_relaxed) == EMPTY) {
                 continue;
             }
-
-            std::unique_lock<std::mutex> lk(queues[target].m, std::try_to_lock);
-            if (!lk.owns_lock()) {
-                continue;
+            std::unique_lock<std::mutex> lk(queues[a].m, std::try_to_lock);
+            if (pop_from(a, out, lk, st)) {
+                from = a;
+                return true;
             }
-
-            if (queues[target].pq.empty()) {
-                queues[target].approx_size.store(0, std::memory_order_relaxed);
+        }
+        for (int idx = 0; idx < queue_count; ++idx) {
+            if (queues[idx].top.load(std::memory_order_relaxed) == EMPTY) {
                 continue;
             }
-
-            out = queues[target].pq.top();
-            queues[target].pq.pop();
-            queues[target].approx_size.fetch_sub(1, std::memory_order_relaxed);
-            return true;
+            std::unique_lock<std::mutex> lk(queues[idx].m);
+            if (pop_from(idx, out, lk, st)) {
+                from = idx;
+                return true;
+            }
         }
         return false;
     };
 
-    auto try_pop = [&](int idx, Node &out) -> bool {
-        if (pop_local(idx, out)) {
-            return true;
+    // Ошибка ранга извлечения — число очередей с верхушкой меньше извлечённого ключа
+    auto sample_rank = [&](LocalStats &st, uint64_t key) {
+        if (++st.pops % Config::PAR_RANK_SAMPLE != 0) {
+            return;
         }
+        uint64_t better = 0;
+        for (const WorkQueue &q: queues) {
+            better += q.top.load(std::memory_order_relaxed) < key;
+        }
+        ++st.rank_samples;
+        st.rank_sum += better;
+    };
 
-        return steal_from(idx, out);
+    // Покой: все вставленные элементы обработаны. completed читается раньше
+    // pushed, оба монотонны и completed <= pushed в любой момент, поэтому
+    // равенство сумм означает, что в некоторый момент между чтениями работы
+    // не было ни в очередях, ни в обработке — а новой взяться уже неоткуда
+    auto quiescent = [&]() {
+        uint64_t completed = 0;
+        uint64_t pushed = 0;
+        for (const Progress &p: progress) {
+            completed += p.completed.load();
+        }
+        for (const Progress &p: progress) {
+            pushed += p.pushed.load();
+        }
+        return completed == pushed;
     };
 
-    auto worker = [&](int idx) {
+    auto worker = [&](int tid) {
         Node cur;
-        while (true) {
-            if (!try_pop(idx, cur)) {
-                if (tasks.load(std::memory_order_relaxed) == 0 && active.load(std::memory_order_relaxed) == 0) {
-                    done.store(true, std::memory_order_relaxed);
-                    cv.notify_all();
-                    break;
-                }
-
-                std::unique_lock<std::mutex> lk(cv_m);
-                cv.wait(lk, [&]() {
-                    return tasks.load(std::memory_order_relaxed) > 0 || done.load(std::memory_order_relaxed);
-                });
-
-                if (tasks.load(std::memory_order_relaxed) == 0 && active.load(std::memory_order_relaxed) == 0) {
+        int from = 0;
+        LocalStats &st = local_stats[tid];
+        for (std::vector<Node> &out: outbox[tid]) {
+            out.reserve(batch);
+        }
+        while (!done.load(std::memory_order_relaxed)) {
+            if (!try_pop(cur, from, tid, st)) {
+                if (quiescent()) {
+                    {
+                        std::lock_guard<std::mutex> lg(sleep_m);
+                        done.store(true, std::memory_order_relaxed);
+                    }
+                    wake.notify_all();
+                    ++st.notifications;
                     break;
                 }
-
+                // Пара к барьеру в flush: либо вставка увидит спящего, либо
+                // спящий увидит вставленную работу
+                std::unique_lock<std::mutex> lk(sleep_m);
+                sleepers.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake.wait(lk, [&]() { return done.load(std::memory_order_relaxed) || any_work(); });
+                sleepers.fetch_sub(1);
                 continue;
             }
 
-            tasks.fetch_sub(1, std::memory_order_relaxed);
-
-            uint64_t curd = dist[cur.v].load(std::memory_order_relaxed);
+            sample_rank(st, cur.dist);
+            const uint64_t bound = target_bound();
+            uint64_t curd = ws.load_dist(cur.v);
+            if (cur.dist >= bound) {
+                drop_queue(from, bound, tid);
+                curd = INF;
+            }
             if (cur.dist != curd) {
-                if (tasks.load(std::memory_order_relaxed) == 0 && active.load(std::memory_order_relaxed) == 0) {
-                    done.store(true, std::memory_order_relaxed);
-                    cv.notify_all();
-                }
+                ++st.stale_pops;
+                progress[tid].completed.fetch_add(1);
                 continue;
             }
+            // При ослабленном порядке вершина может раскрыться снова после
+            // улучшения расстояния; в settled идёт только первое раскрытие
+            if (ws.try_settle(cur.v)) {
+                ++st.settled;
+            } else {
+                ++st.reexpansions;
+            }
 
-            active.fetch_add(1, std::memory_order_relaxed);
-
-            for (auto [to, w]: g_.adj[cur.v]) {
-                uint64_t nd = curd + w;
-                uint64_t old = dist[to].load(std::memory_order_relaxed);
-
-                while (nd < old) {
-                    if (dist[to].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {
-                        parent[to].store(cur.v, std::memory_order_relaxed);
-                        int owner = threads > 0 ? (to % threads) : 0;
-                        push_to(owner, Node{nd, to});
-                        break;
+            for (uint64_t e = off[cur.v]; e < off[cur.v + 1]; ++e) {
+                int to = targets[e];
+                uint64_t nd = curd + weights[e];
+                if (nd >= bound) {
+                    continue;
+                }
+                if (ws.try_relax(to, nd, cur.v)) {
+                    const int group = partition ? partition->part(to) : 0;
+                    std::vector<Node> &out = outbox[tid][group];
+                    out.push_back(Node{nd, to});
+                    if (out.size() >= batch) {
+                        flush_group(tid, group);
                     }
                 }
             }
-
-            active.fetch_sub(1, std::memory_order_relaxed);
-
-            if (tasks.load(std::memory_order_relaxed) == 0 && active.load(std::memory_order_relaxed) == 0) {
-                done.store(true, std::memory_order_relaxed);
-                cv.notify_all();
-            }
+            // Остаток не ждёт следующей вершины: иначе малые ключи задержались
+            // бы в буфере, пока другие потоки берут худшие
+            flush(tid);
+            progress[tid].completed.fetch_add(1);
         }
     };
 
-    dist[start_].store(0, std::memory_order_relaxed);
-    int start_owner = threads > 0 ? (start_ % threads) : 0;
-    push_to(start_owner, Node{0, start_});
-
-    std::vector<std::thread> pool;
-    pool.reserve(threads);
-    for (int t = 0; t < threads; ++t) {
-        pool.emplace_back(worker, t);
-    }
-
-    for (auto &th: pool) {
-        th.join();
+    ws.try_relax(start_, 0, -1);
+    outbox[0][partition ? partition->part(start_) : 0].push_back(Node{0, start_});
+    flush(0);
+
+    pool_->run(worker);
+
+    stats_ = {};
+    for (const LocalStats &st: local_stats) {
+        stats_.pops += st.pops;
+        stats_.stale_pops += st.stale_pops;
+        stats_.rank_samples += st.rank_samples;
+        stats_.rank_sum += st.rank_sum;
+        stats_.pushes += st.pushes;
+        stats_.cross_pushes += st.cross_pushes;
+        stats_.locks += st.locks;
+        stats_.notifications += st.notifications;
+        stats_.settled += st.settled;
+        stats_.reexpansions += st.reexpansions;
     }
 
-    DijkstraParResult res;
-    res.dist.resize(n);
-    res.parent.resize(n);
-    for (int i = 0; i < n; ++i) {
-        res.dist[i] = dist[i].load(std::memory_order_relaxed);
-        res.parent[i] = parent[i].load(std::memory_order_relaxed);
-    }
-
-    return res;
+    return {ws, stats_.settled};
 }
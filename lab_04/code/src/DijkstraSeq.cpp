@@ -1,40 +1,67 @@
 #include "DijkstraSeq.h"
 #include "Graph.h"
+#include "TargetSet.h"
 
 DijkstraSequential::DijkstraSequential(const Graph &g, int start)
+    : own_(std::make_unique<CsrGraph>(g)), g_(*own_), start_(start) {}
+
+DijkstraSequential::DijkstraSequential(const CsrGraph &g, int start)
     : g_(g), start_(start) {}
 
+void DijkstraSequential::set_targets(const std::vector<int> &targets) {
+    targets_ = targets;
+}
+
+void DijkstraSequential::set_record_parents(bool record) {
+    record_parents_ = record;
+}
+
 DijkstraResult DijkstraSequential::run() {
-    const uint64_t INF = Config::INF;
-    const int n = static_cast<int>(g_.adj.size());
+    QueryWorkspace ws;
+    QueryView r = run(ws);
+    return {r.dist_vector(), r.parent_vector(), r.settled()};
+}
 
-    std::vector<uint64_t> dist(n, INF);
-    std::vector<int> parent(n, -1);
+QueryView DijkstraSequential::run(QueryWorkspace &ws) {
+    const int n = static_cast<int>(g_.size());
+    const uint64_t *off = g_.offsets();
+    const int *to = g_.targets();
+    const uint32_t *wt = g_.weights();
 
-    dist[start_] = 0;
-    std::vector<char> used(n, 0);
+    ws.begin(n, record_parents_);
+    ws.reach(start_, 0, -1);
+    TargetSet left(targets_);
+    uint64_t settled = 0;
 
     for (int iter = 0; iter < n; ++iter) {
         int u = -1;
-        uint64_t best = INF;
+        uint64_t best = Config::INF;
         for (int i = 0; i < n; ++i) {
-            if (!used[i] && dist[i] < best) {
-                best = dist[i];
+            if (ws.reached(i) && !ws.settled(i) && ws.dist(i) < best) {
+                best = ws.dist(i);
                 u = i;
             }
         }
-        if (u == -1 || best == INF) {
+        if (u == -1) {
+            break;
+        }
+        ws.settle(u);
+        ++settled;
+        if (left.settle(u)) {
             break;
         }
-        used[u] = 1;
-        for (auto [v, w]: g_.adj[u]) {
-            uint64_t nd = best + w;
-            if (nd < dist[v]) {
-                dist[v] = nd;
-                parent[v] = u;
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            int v = to[e];
+            uint64_t nd = best + wt[e];
+            if (nd < ws.dist(v)) {
+                if (record_parents_) {
+                    ws.reach(v, nd, u);
+                } else {
+                    ws.reach(v, nd);
+                }
             }
         }
     }
 
-    return {std::move(dist), std::move(parent)};
+    return {ws, settled};
 }
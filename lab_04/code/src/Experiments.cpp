@@ -1,18 +1,31 @@
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "CsrGraph.h"
+#include "DijkstraBatch.h"
+#include "DijkstraBucket.h"
+#include "DijkstraDense.h"
+#include "DijkstraHeap.h"
 #include "DijkstraPar.h"
 #include "DijkstraSeq.h"
 #include "Experiments.h"
 #include "Graph.h"
+#include "GraphPartition.h"
+#include "NearestTargets.h"
+#include "PerfCounter.h"
 #include "Timer.h"
+#include "VertexOrder.h"
+#include "WorkerPool.h"
 
 #include <map>
 
@@ -47,6 +60,378 @@ void ExperimentRunner::run_comparative_analysis() {
     analyze_and_recommend(results, logical_cores);
 }
 
+void ExperimentRunner::run_load_benchmark(const std::string &filename, int runs, int load_threads) {
+    const double megabytes = static_cast<double>(std::filesystem::file_size(filename)) / (1024.0 * 1024.0);
+
+    std::cout << "=== ПРОПУСКНАЯ СПОСОБНОСТЬ ЗАГРУЗКИ DOT ===" << std::endl;
+    std::cout << "Файл: " << filename << " (" << megabytes << " МБ)" << std::endl;
+
+    if (load_threads <= 0) {
+        load_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int threads: {1, load_threads}) {
+        std::vector<long long> times;
+        int edges = 0;
+        for (int i = 0; i < runs; ++i) {
+            Timer timer;
+            Graph g = threads == 1 ? Graph::load_from_dot(filename) : Graph::load_from_dot_parallel(filename, threads);
+            times.push_back(timer.us());
+            edges = count_edges(g);
+        }
+
+        std::sort(times.begin(), times.end());
+        const long long median_us = times[times.size() / 2];
+        const double seconds = static_cast<double>(std::max(1LL, median_us)) / 1e6;
+
+        std::cout << "\nПотоки=" << threads << ", дуг: " << edges << ", запусков: " << runs << std::endl;
+        std::cout << "Время (медиана): " << median_us << " us" << std::endl;
+        std::cout << "Скорость: " << megabytes / seconds << " МБ/с, "
+                  << static_cast<long long>(edges / seconds) << " дуг/с" << std::endl;
+
+        if (load_threads == 1) {
+            break;
+        }
+    }
+}
+
+void ExperimentRunner::run_engine_benchmark(int runs) {
+    std::cout << "=== ЛИНЕЙНЫЙ ПОИСК МИНИМУМА ПРОТИВ КУЧИ И КОРЗИН ===" << std::endl;
+    std::cout << "n,degree,edges,linear_us,dense_us,heap2_us,heap4_us,heap8_us,dial_us,radix_us" << std::endl;
+
+    auto median_us = [runs](auto &&run) {
+        std::vector<long long> times;
+        for (int i = 0; i < runs; ++i) {
+            Timer timer;
+            run();
+            times.push_back(timer.us());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    };
+
+    // Разреженные графы (степень 4) против плотных (степень ~ n/8)
+    for (int n: {1000, 4000, 16000}) {
+        for (int degree: {4, n / 8}) {
+            Graph g = make_random_graph(n, degree, static_cast<uint32_t>(n + degree));
+            CsrGraph csr(g);
+
+            long long linear = median_us([&] { DijkstraSequential(csr, 0).run(); });
+            // Плотный движок — только пока матрица помещается в предел; -1 — пропуск
+            long long dense_us = -1;
+            if (static_cast<size_t>(n) <= Config::DENSE_MAX_VERTICES) {
+                DenseGraph dense(csr);
+                dense_us = median_us([&] { DijkstraDense(dense, 0).run(); });
+            }
+            long long heap[3];
+            int arities[3] = {2, 4, 8};
+            for (int i = 0; i < 3; ++i) {
+                heap[i] = median_us([&] { DijkstraHeap(csr, 0, arities[i]).run(); });
+            }
+            long long dial = median_us([&] { DijkstraBucket(csr, 0, DijkstraBucket::Strategy::Dial).run(); });
+            long long radix = median_us([&] { DijkstraBucket(csr, 0, DijkstraBucket::Strategy::Radix).run(); });
+
+            std::cout << n << "," << degree << "," << csr.edge_count() << "," << linear << "," << dense_us << ","
+                      << heap[0] << "," << heap[1] << "," << heap[2] << "," << dial << "," << radix << std::endl;
+        }
+    }
+}
+
+void ExperimentRunner::run_scheduler_benchmark(int runs) {
+    std::cout << "=== MULTIQUEUE: ОЧЕРЕДЕЙ НА ПОТОК (c) ПРОТИВ КАЧЕСТВА ПОРЯДКА ===" << std::endl;
+    std::cout << "n,degree,threads,c,time_us,rank_error,stale_ratio,pushes,locks,notifications" << std::endl;
+
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    for (int n: {4000, 16000}) {
+        for (int degree: {4, n / 8}) {
+            Graph g = make_random_graph(n, degree, static_cast<uint32_t>(n + degree));
+            CsrGraph csr(g);
+            for (int threads: generate_thread_counts(cores)) {
+                for (int c: {1, 2, 4, 8}) {
+                    DijkstraParallel engine(csr, 0, threads);
+                    engine.set_queue_factor(c);
+                    // Медиана времени; статистика порядка — с того же запуска
+                    std::vector<std::pair<long long, SchedulerStats>> samples;
+                    for (int i = 0; i < runs; ++i) {
+                        Timer timer;
+                        engine.run(workspace_);
+                        samples.emplace_back(timer.us(), engine.stats());
+                    }
+                    std::sort(samples.begin(), samples.end(),
+                              [](const auto &a, const auto &b) { return a.first < b.first; });
+                    const auto &[time_us, st] = samples[samples.size() / 2];
+                    std::cout << n << "," << degree << "," << threads << "," << c << "," << time_us << ","
+                              << st.rank_error() << "," << st.stale_ratio() << "," << st.pushes << "," << st.locks
+                              << "," << st.notifications << std::endl;
+                }
+            }
+        }
+    }
+}
+
+void ExperimentRunner::run_pool_benchmark(int queries) {
+    std::cout << "=== НАКЛАДНЫЕ РАСХОДЫ ЗАПРОСА: НОВЫЕ ПОТОКИ ПРОТИВ ПОСТОЯННОГО ПУЛА ===" << std::endl;
+    std::cout << "n,threads,spawn_us,pool_us" << std::endl;
+
+    // Среднее на запрос: на малых графах время почти целиком — запуск потоков
+    auto mean_us = [queries](auto &&query) {
+        Timer timer;
+        for (int i = 0; i < queries; ++i) {
+            query();
+        }
+        return static_cast<double>(timer.us()) / queries;
+    };
+
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    for (int n: {16, 256, 2048}) {
+        Graph g = make_random_graph(n, 4, static_cast<uint32_t>(n));
+        CsrGraph csr(g);
+        for (int threads: generate_thread_counts(cores)) {
+            if (threads == 0) {
+                continue;
+            }
+            // Как прежде: каждый запрос заводит и завершает свои потоки
+            double spawn = mean_us([&] {
+                DijkstraParallel engine(csr, 0, threads);
+                engine.run(workspace_);
+            });
+            auto pool = std::make_shared<WorkerPool>(threads);
+            double pooled = mean_us([&] {
+                DijkstraParallel engine(csr, 0, threads);
+                engine.set_pool(pool);
+                engine.run(workspace_);
+            });
+            std::cout << n << "," << threads << "," << spawn << "," << pooled << std::endl;
+        }
+    }
+}
+
+void ExperimentRunner::run_batch_benchmark(int runs) {
+    std::cout << "=== МНОГО ИСТОКОВ: ПОИСК ИЗ КАЖДОГО ПРОТИВ ВЕКТОРНОЙ ГРУППЫ ===" << std::endl;
+    std::cout << "n,degree,sources,single_us,batch_us" << std::endl;
+
+    auto median_us = [runs](auto &&run) {
+        std::vector<long long> times;
+        for (int i = 0; i < runs; ++i) {
+            Timer timer;
+            run();
+            times.push_back(timer.us());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    };
+
+    for (int n: {4000, 16000}) {
+        for (int degree: {4, n / 8}) {
+            Graph g = make_random_graph(n, degree, static_cast<uint32_t>(n + degree));
+            CsrGraph csr(g);
+            std::mt19937 rng(static_cast<uint32_t>(n));
+            std::uniform_int_distribution<int> vd(0, n - 1);
+            for (int count: {4, 8, 16}) {
+                std::vector<int> sources(count);
+                for (int &s: sources) {
+                    s = vd(rng);
+                }
+                // Оба варианта строят parent: бинарная куча на каждый исток против группы
+                long long single = median_us([&] {
+                    for (int s: sources) {
+                        DijkstraHeap(csr, s, 2).run();
+                    }
+                });
+                long long batch = median_us([&] { DijkstraBatch(csr, sources).run(); });
+                std::cout << n << "," << degree << "," << count << "," << single << "," << batch << std::endl;
+            }
+        }
+    }
+}
+
+void ExperimentRunner::run_nearest_benchmark(int queries) {
+    std::cout << "=== БЛИЖАЙШАЯ ЦЕЛЬ: ТАБЛИЦА ПРОТИВ ПОИСКА НА КАЖДЫЙ ЗАПРОС ===" << std::endl;
+    std::cout << "n,degree,targets,build_us,table_query_ns,search_query_us,break_even" << std::endl;
+
+    for (int n: {20000, 100000}) {
+        for (int degree: {4, 16}) {
+            Graph g = make_random_graph(n, degree, static_cast<uint32_t>(n + degree));
+            CsrGraph csr(g);
+            std::mt19937 rng(static_cast<uint32_t>(n));
+            std::uniform_int_distribution<int> vd(0, n - 1);
+            std::vector<int> starts(queries);
+            for (int &s: starts) {
+                s = vd(rng);
+            }
+            for (int count: {1, 16, 256}) {
+                std::vector<int> targets(count);
+                for (int &t: targets) {
+                    t = vd(rng);
+                }
+
+                Timer build_timer;
+                NearestTargets table = NearestTargets::build(csr, targets);
+                const long long build = build_timer.us();
+
+                // Таблица отдаёт путь до ближайшей цели; поиск, как в основном режиме,
+                // идёт до последней цели
+                Timer table_timer;
+                for (int s: starts) {
+                    table.path(s);
+                }
+                const long long table_us = table_timer.us();
+
+                Timer search_timer;
+                for (int s: starts) {
+                    DijkstraHeap heap(csr, s, 2);
+                    heap.set_targets(targets);
+                    heap.run();
+                }
+                const long long search_us = search_timer.us();
+
+                // Сколько запросов окупают построение таблицы
+                const long long per_search = search_us / queries;
+                const long long per_table_ns = table_us * 1000 / queries;
+                const long long saved_ns = per_search * 1000 - per_table_ns;
+                const long long break_even = saved_ns > 0 ? (build * 1000 + saved_ns - 1) / saved_ns : -1;
+                std::cout << n << "," << degree << "," << count << "," << build << "," << per_table_ns << ","
+                          << per_search << "," << break_even << std::endl;
+            }
+        }
+    }
+}
+
+void ExperimentRunner::run_reorder_benchmark(int runs) {
+    std::cout << "=== ПЕРЕНУМЕРАЦИЯ ВЕРШИН: ВРЕМЯ И ПРОМАХИ КЭША ===" << std::endl;
+    std::cout << "graph,n,order,reorder_ms,heap_us,heap_misses,par_us,par_misses" << std::endl;
+
+    // Медиана времени; промахи — с того же запуска (-1: счётчик недоступен)
+    PerfCounter counter;
+    auto measure = [&](auto &&run) {
+        std::vector<std::pair<long long, long long>> samples;
+        for (int i = 0; i < runs; ++i) {
+            Timer timer;
+            counter.start();
+            run();
+            long long misses = counter.stop();
+            samples.emplace_back(timer.us(), misses);
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    };
+
+    // Случайный граф не имеет локальности ни в каком порядке; решётка с
+    // перемешанными номерами (как дороги из DOT) её теряет только из-за нумерации
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("random", make_random_graph(1 << 20, 4, 2024));
+    graphs.emplace_back("grid", make_grid_graph(1024, 2024));
+    for (const auto &[name, g]: graphs) {
+        CsrGraph base(g);
+        for (const char *order_name: {"none", "bfs", "rcm", "degree"}) {
+            // Запрос один и тот же: из исходной вершины 0
+            const bool keep = std::string(order_name) == "none";
+            Timer reorder_timer;
+            CsrGraph reordered;
+            int start = 0;
+            if (!keep) {
+                VertexOrder order = VertexOrder::compute(base, VertexOrder::parse(order_name));
+                reordered = base.permuted(order.order());
+                start = order.to_new(0);
+            }
+            const long long reorder_ms = reorder_timer.ms();
+            const CsrGraph &csr = keep ? base : reordered;
+
+            // Параллельный движок на одном потоке: счётчик видит только вызывающий поток
+            auto [heap_us, heap_misses] = measure([&] { DijkstraHeap(csr, start).run(); });
+            DijkstraParallel par(csr, start, 1);
+            auto [par_us, par_misses] = measure([&] { par.run(workspace_); });
+            std::cout << name << "," << g.size() << "," << order_name << "," << reorder_ms << "," << heap_us << ","
+                      << heap_misses << "," << par_us << "," << par_misses << std::endl;
+        }
+    }
+}
+
+void ExperimentRunner::run_partition_benchmark(int runs) {
+    std::cout << "=== ВЛАДЕЛЬЦЫ ВЕРШИН: СЛУЧАЙНЫЕ ОЧЕРЕДИ ПРОТИВ РАЗБИЕНИЯ ГРАФА ===" << std::endl;
+    std::cout << "graph,threads,owners,cut_fraction,partition_ms,time_us,cross_ratio,rank_error,stale_ratio" << std::endl;
+
+    std::vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("random", make_random_graph(1 << 18, 4, 2025));
+    graphs.emplace_back("grid", make_grid_graph(512, 2025));
+    for (const auto &[name, g]: graphs) {
+        CsrGraph csr(g);
+        for (int threads: {2, 4, 8}) {
+            Timer partition_timer;
+            auto partition = std::make_shared<GraphPartition>(GraphPartition::build(csr, threads));
+            const long long partition_ms = partition_timer.ms();
+
+            for (bool owned: {false, true}) {
+                DijkstraParallel engine(csr, 0, threads);
+                if (owned) {
+                    engine.set_partition(partition);
+                }
+                // Медиана времени; статистика — с того же запуска
+                std::vector<std::pair<long long, SchedulerStats>> samples;
+                for (int i = 0; i < runs; ++i) {
+                    Timer timer;
+                    engine.run(workspace_);
+                    samples.emplace_back(timer.us(), engine.stats());
+                }
+                std::sort(samples.begin(), samples.end(),
+                          [](const auto &a, const auto &b) { return a.first < b.first; });
+                const auto &[time_us, st] = samples[samples.size() / 2];
+                // У случайных очередей владельцев нет: разрез и время разбиения не определены
+                std::cout << name << "," << threads << "," << (owned ? "partition" : "random") << ","
+                          << (owned ? partition->cut_fraction() : -1.0) << "," << (owned ? partition_ms : -1) << ","
+                          << time_us << "," << st.cross_ratio() << "," << st.rank_error() << "," << st.stale_ratio()
+                          << std::endl;
+            }
+        }
+    }
+}
+
+Graph ExperimentRunner::make_random_graph(int vertices, int out_degree, uint32_t seed) {
+    Graph g;
+    g.adj.reserve(vertices);
+    for (int i = 0; i < vertices; ++i) {
+        g.ensure_node(std::to_string(i));
+    }
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vd(0, vertices - 1);
+    std::uniform_int_distribution<int> wd(1, 100);
+    for (int u = 0; u < vertices; ++u) {
+        for (int i = 0; i < out_degree; ++i) {
+            g.add_edge(u, vd(rng), static_cast<uint32_t>(wd(rng)));
+        }
+    }
+    return g;
+}
+
+Graph ExperimentRunner::make_grid_graph(int side, uint32_t seed) {
+    // Клетки получают номера в случайном порядке, дуги — в обе стороны к соседям
+    const int n = side * side;
+    std::vector<int> cells(n);
+    std::iota(cells.begin(), cells.end(), 0);
+    std::mt19937 rng(seed);
+    std::shuffle(cells.begin(), cells.end(), rng);
+
+    Graph g;
+    g.adj.reserve(n);
+    std::vector<int> id(n);
+    for (int c: cells) {
+        id[c] = g.ensure_node(std::to_string(c));
+    }
+    std::uniform_int_distribution<int> wd(1, 100);
+    for (int c = 0; c < n; ++c) {
+        const int r = c / side;
+        const int col = c % side;
+        if (col + 1 < side) {
+            g.add_edge(id[c], id[c + 1], static_cast<uint32_t>(wd(rng)));
+            g.add_edge(id[c + 1], id[c], static_cast<uint32_t>(wd(rng)));
+        }
+        if (r + 1 < side) {
+            g.add_edge(id[c], id[c + side], static_cast<uint32_t>(wd(rng)));
+            g.add_edge(id[c + side], id[c], static_cast<uint32_t>(wd(rng)));
+        }
+    }
+    return g;
+}
+
 std::vector<ExperimentRunner::GraphInfo> ExperimentRunner::generate_test_graphs() {
     std::vector<int> sizes = {3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000};
     std::vector<GraphInfo> graphs;
@@ -61,7 +446,7 @@ std::vector<ExperimentRunner::GraphInfo> ExperimentRunner::generate_test_graphs(
         }
 
         try {
-            Graph g = Graph::load_from_dot(filename);
+            Graph g = load_graph_cached(filename);
             int edge_count = count_edges(g);
             graphs.push_back({filename, size, edge_count});
         } catch (const std::exception &e) {
@@ -72,6 +457,28 @@ std::vector<ExperimentRunner::GraphInfo> ExperimentRunner::generate_test_graphs(
     return graphs;
 }
 
+Graph ExperimentRunner::load_graph_cached(const std::string &filename) {
+    // Рядом с DOT хранится бинарный снимок, который обновляется при изменении DOT
+    std::filesystem::path bin = std::filesystem::path(filename).replace_extension(".bin");
+    std::error_code ec;
+    if (std::filesystem::exists(bin, ec) &&
+        std::filesystem::last_write_time(bin, ec) >= std::filesystem::last_write_time(filename, ec)) {
+        try {
+            return Graph::load_binary(bin.string());
+        } catch (const std::exception &e) {
+            std::cerr << "Снимок " << bin << " не прочитан: " << e.what() << std::endl;
+        }
+    }
+
+    Graph g = Graph::load_from_dot(filename);
+    try {
+        g.save_binary(bin.string());
+    } catch (const std::exception &e) {
+        std::cerr << "Не удалось сохранить снимок " << bin << ": " << e.what() << std::endl;
+    }
+    return g;
+}
+
 void ExperimentRunner::generate_graph(int vertices, const std::string &filename) {
     std::string command = "python3 generate_graph.py " + std::to_string(vertices) + " " + filename + " 0 -t > /dev/null";
     int result = system(command.c_str());
@@ -168,11 +575,13 @@ ExperimentRunner::ExperimentResult ExperimentRunner::run_experiment_series(const
 
     for (int i = 0; i < runs; ++i) {
         try {
-            Graph g = Graph::load_from_dot(graph_info.filename);
+            Graph g = load_graph_cached(graph_info.filename);
             int start_node = 0;
             std::vector<int> target_nodes = load_target_nodes(g, graph_info.filename);
 
-            long long time = run_single_experiment(g, start_node, target_nodes, threads);
+            CsrGraph csr(g);
+
+            long long time = run_single_experiment(csr, start_node, target_nodes, threads);
             times.push_back(time);
 
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -196,18 +605,21 @@ ExperimentRunner::ExperimentResult ExperimentRunner::run_experiment_series(const
     return {graph_info.vertex_count, threads, avg_time, threads == 0};
 }
 
-long long ExperimentRunner::run_single_experiment(const Graph &g, int start_node, const std::vector<int> &target_nodes, int threads) {
+long long ExperimentRunner::run_single_experiment(const CsrGraph &g, int start_node, const std::vector<int> &target_nodes, int threads) {
     long time = 0;
 
+    // Замеряется только поиск расстояний: пути экспериментам не нужны
     if (threads == 0) {
         DijkstraSequential seq(g, start_node);
+        seq.set_record_parents(false);
         Timer timer;
-        auto result = seq.run();
+        seq.run(workspace_);
         time = timer.us();
     } else {
         DijkstraParallel par(g, start_node, threads);
+        par.set_record_parents(false);
         Timer timer;
-        auto result = par.run();
+        par.run(workspace_);
         time = timer.us();
     }
 
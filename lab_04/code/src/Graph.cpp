@@ -1,32 +1,26 @@
-#include <fstream>
-#include <regex>
-#include <sstream>
+#include <algorithm>
+#include <exception>
 #include <stdexcept>
-#include <unordered_set>
+#include <string_view>
+#include <thread>
 
+#include "Config.h"
+#include "DotParser.h"
 #include "Graph.h"
+#include "GraphSnapshot.h"
+#include "MappedFile.h"
 
-int Graph::ensure_node(const std::string &name) {
-    auto it = name_to_idx.find(name);
-    if (it != name_to_idx.end()) {
-        return it->second;
+int Graph::ensure_node(std::string_view name) {
+    int idx = names.intern(name);
+    if (idx == static_cast<int>(adj.size())) {
+        adj.emplace_back();
     }
 
-    int idx = static_cast<int>(adj.size());
-    name_to_idx.emplace(name, idx);
-    idx_to_name.push_back(name);
-    adj.emplace_back();
-
     return idx;
 }
 
-std::optional<int> Graph::find_node(const std::string &name) const {
-    auto it = name_to_idx.find(name);
-    if (it == name_to_idx.end()) {
-        return std::nullopt;
-    }
-
-    return it->second;
+std::optional<int> Graph::find_node(std::string_view name) const {
+    return names.find(name);
 }
 
 void Graph::add_edge(int u, int v, uint32_t w) {
@@ -37,81 +31,238 @@ void Graph::add_edge(int u, int v, uint32_t w) {
     adj[u].emplace_back(v, w);
 }
 
-static std::string trim(const std::string &s) {
-    size_t i = 0, j = s.size();
-    while (i < j && isspace(static_cast<unsigned char>(s[i]))) {
-        ++i;
+// Переупорядочивает вершины так, как их нумеровал прежний загрузчик:
+// сначала объявленные вершины в порядке объявления, затем остальные
+// в порядке первого появления в дугах.
+static void restore_declaration_order(Graph &g, const std::vector<int> &decl_seq) {
+    const int n = static_cast<int>(g.size());
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
     }
-    while (j > i && isspace(static_cast<unsigned char>(s[j - 1]))) {
-        --j;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        bool da = decl_seq[a] >= 0, db = decl_seq[b] >= 0;
+        if (da != db) return da;
+        return da && decl_seq[a] < decl_seq[b];
+    });
+
+    std::vector<int> new_idx(n);
+    bool identity = true;
+    for (int i = 0; i < n; ++i) {
+        new_idx[order[i]] = i;
+        identity = identity && order[i] == i;
+    }
+    if (identity) {
+        return;
     }
 
-    return s.substr(i, j - i);
+    Graph r;
+    r.adj.resize(n);
+    r.names.reserve(n, g.names.bytes());
+    for (int i = 0; i < n; ++i) {
+        r.names.intern(g.name(order[i]));
+    }
+    for (int old = 0; old < n; ++old) {
+        int v = new_idx[old];
+        r.adj[v] = std::move(g.adj[old]);
+        for (auto &e: r.adj[v]) {
+            e.first = new_idx[e.first];
+        }
+    }
+    g = std::move(r);
 }
 
-static std::string unquote(const std::string &s) {
-    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') {
-        return s.substr(1, s.size() - 2);
+static void parse_dot_text(Graph &g, std::string_view text) {
+    DotParser parser(text);
+    DotStatement st;
+
+    std::vector<int> decl_seq;
+    int declared = 0;
+    bool reorder = false;
+
+    auto intern = [&](std::string_view name) {
+        int before = static_cast<int>(g.size());
+        int idx = g.ensure_node(name);
+        if (idx == before) {
+            decl_seq.push_back(-1);
+        }
+        return idx;
+    };
+
+    while (parser.next(st)) {
+        if (st.kind == DotStatement::Kind::Node) {
+            int before = static_cast<int>(g.size());
+            int idx = intern(st.from);
+            if (decl_seq[idx] < 0) {
+                // Объявление после неявно созданных вершин меняет нумерацию
+                reorder = reorder || idx != before || declared != before;
+                decl_seq[idx] = declared++;
+            }
+        } else {
+            int u = intern(st.from);
+            int v = intern(st.to);
+            g.add_edge(u, v, st.weight);
+        }
     }
 
-    return s;
+    if (reorder) {
+        restore_declaration_order(g, decl_seq);
+    }
 }
 
-Graph Graph::load_from_dot(const std::string &path) {
-    std::ifstream in(path);
-    if (!in) {
-        throw std::runtime_error("Failed to open DOT file: " + path);
+void Graph::save_binary(const std::string &path) const {
+    GraphSnapshot::save(*this, path);
+}
+
+Graph Graph::load_binary(const std::string &path) {
+    return GraphSnapshot::open(path).to_graph();
+}
+
+static void check_digraph(std::string_view text) {
+    if (text.find("digraph") == std::string_view::npos) {
+        throw std::runtime_error("DOT must be a digraph with '->' arcs");
     }
+}
 
-    std::stringstream buf;
-    buf << in.rdbuf();
-    std::string text = buf.str();
+Graph Graph::load_from_dot(const std::string &path) {
+    MappedFile file(path);
+    check_digraph(file.view());
 
     Graph g;
+    parse_dot_text(g, file.view());
+    return g;
+}
 
-    std::regex edge_re(R"(("[^"]+"|[A-Za-z0-9_]+)\s*->\s*("[^"]+"|[A-Za-z0-9_]+)\s*(\[(.*?)\])?\s*;)");
-    std::regex node_re(R"(^\s*("[^"]+"|[A-Za-z0-9_]+)\s*;\s*$)");
-    std::regex weight_kv_re(R"((label|weight)\s*=\s*([0-9]+))");
+namespace {
+    // Результат разбора одного куска файла: локальные имена в порядке
+    // первого появления, объявленные вершины и дуги в локальных индексах.
+    class DotChunk {
+    public:
+        NameTable names;
+        std::vector<int> declared;
+        std::vector<std::pair<int, int>> arcs;
+        std::vector<uint32_t> weights;
 
-    if (text.find("digraph") == std::string::npos) {
-        throw std::runtime_error("DOT must be a digraph with '->' arcs");
+        void parse(std::string_view text) {
+            DotParser parser(text);
+            DotStatement st;
+            while (parser.next(st)) {
+                if (st.kind == DotStatement::Kind::Node) {
+                    declared.push_back(names.intern(st.from));
+                } else {
+                    int u = names.intern(st.from);
+                    int v = names.intern(st.to);
+                    arcs.emplace_back(u, v);
+                    weights.push_back(st.weight);
+                }
+            }
+        }
+    };
+
+    // Границы кусков ставятся после ';' в конце строки, чтобы каждый
+    // кусок начинался с нового оператора.
+    std::vector<size_t> split_statements(std::string_view text, int parts) {
+        std::vector<size_t> bounds{0};
+        for (int i = 1; i < parts; ++i) {
+            size_t pos = std::max(bounds.back(), text.size() / parts * i);
+            while (pos < text.size()) {
+                size_t semi = text.find(';', pos);
+                if (semi == std::string_view::npos) {
+                    pos = text.size();
+                    break;
+                }
+                size_t j = semi + 1;
+                while (j < text.size() && (text[j] == ' ' || text[j] == '\t' || text[j] == '\r')) {
+                    ++j;
+                }
+                if (j < text.size() && text[j] == '\n') {
+                    pos = j + 1;
+                    break;
+                }
+                pos = j;
+            }
+            if (pos > bounds.back() && pos < text.size()) {
+                bounds.push_back(pos);
+            }
+        }
+        bounds.push_back(text.size());
+        return bounds;
+    }
+}// namespace
+
+Graph Graph::load_from_dot_parallel(const std::string &path, int threads) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    MappedFile file(path);
+    std::string_view text = file.view();
+    check_digraph(text);
+
+    // Маленькие файлы и блочные комментарии (могут содержать ";\n") разбираются последовательно
+    if (threads == 1 || text.size() < Config::PARALLEL_LOAD_MIN_BYTES || text.find("/*") != std::string_view::npos) {
+        Graph g;
+        parse_dot_text(g, text);
+        return g;
     }
 
-    {
-        std::stringstream ss(text);
-        std::string line;
-        while (std::getline(ss, line)) {
-            std::smatch m;
-            if (std::regex_search(line, m, node_re)) {
-                std::string name = unquote(trim(m[1].str()));
-                g.ensure_node(name);
+    std::vector<size_t> bounds = split_statements(text, threads);
+    const int parts = static_cast<int>(bounds.size()) - 1;
+
+    std::vector<DotChunk> chunks(parts);
+    std::vector<std::exception_ptr> errors(parts);
+    std::vector<std::thread> pool;
+    pool.reserve(parts);
+    for (int i = 0; i < parts; ++i) {
+        pool.emplace_back([&, i]() {
+            try {
+                chunks[i].parse(text.substr(bounds[i], bounds[i + 1] - bounds[i]));
+            } catch (...) {
+                errors[i] = std::current_exception();
             }
+        });
+    }
+    for (auto &th: pool) {
+        th.join();
+    }
+    for (auto &e: errors) {
+        if (e) {
+            std::rethrow_exception(e);
         }
     }
 
-    {
-        auto it = std::sregex_iterator(text.begin(), text.end(), edge_re);
-        auto end = std::sregex_iterator();
-        for (; it != end; ++it) {
-            const std::smatch &m = *it;
-            std::string u_name = unquote(m[1].str());
-            std::string v_name = unquote(m[2].str());
-            std::string attrs = m[4].matched ? m[4].str() : std::string();
-            uint32_t w = 1;
-            if (!attrs.empty()) {
-                std::smatch wm;
-                if (std::regex_search(attrs, wm, weight_kv_re)) {
-                    unsigned long long val = std::stoull(wm[2].str());
-                    if (val > UINT32_MAX) {
-                        throw std::runtime_error("Weight exceeds 32-bit range");
-                    }
-                    w = static_cast<uint32_t>(val);
-                }
+    // Детерминированное слияние: сначала объявленные вершины, затем
+    // остальные в порядке первого появления — как в последовательном загрузчике
+    Graph g;
+    std::vector<std::vector<int>> to_global(parts);
+    for (int i = 0; i < parts; ++i) {
+        to_global[i].assign(chunks[i].names.size(), -1);
+        for (int local: chunks[i].declared) {
+            to_global[i][local] = g.ensure_node(chunks[i].names.name(local));
+        }
+    }
+    for (int i = 0; i < parts; ++i) {
+        for (size_t local = 0; local < chunks[i].names.size(); ++local) {
+            if (to_global[i][local] < 0) {
+                to_global[i][local] = g.ensure_node(chunks[i].names.name(local));
             }
+        }
+    }
 
-            int u = g.ensure_node(u_name);
-            int v = g.ensure_node(v_name);
-            g.add_edge(u, v, w);
+    std::vector<uint32_t> degree(g.size(), 0);
+    for (int i = 0; i < parts; ++i) {
+        for (auto [u, v]: chunks[i].arcs) {
+            ++degree[to_global[i][u]];
+        }
+    }
+    for (size_t u = 0; u < g.size(); ++u) {
+        g.adj[u].reserve(degree[u]);
+    }
+    for (int i = 0; i < parts; ++i) {
+        const auto &map = to_global[i];
+        for (size_t e = 0; e < chunks[i].arcs.size(); ++e) {
+            auto [u, v] = chunks[i].arcs[e];
+            g.adj[map[u]].emplace_back(map[v], chunks[i].weights[e]);
         }
     }
 
@@ -0,0 +1,255 @@
+#include "GraphSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "Graph.h"
+#include "MappedFile.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'I', 'U', '7', 'G', 'R', 'A', 'P', 'H'};
+
+    size_t align8(size_t x) {
+        return (x + 7) & ~static_cast<size_t>(7);
+    }
+
+    bool non_decreasing(const uint64_t *a, size_t len) {
+        for (size_t i = 1; i < len; ++i) {
+            if (a[i] < a[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Все номера в [0, n): иначе CSR и бинпоиск по именам читают за пределами массивов
+    bool in_range(const int *a, size_t len, size_t n) {
+        bool ok = true;
+        for (size_t i = 0; i < len; ++i) {
+            ok &= static_cast<size_t>(static_cast<uint32_t>(a[i])) < n;
+        }
+        return ok;
+    }
+
+    // Пословный FNV-подобный хеш; неполное последнее слово дополняется нулями,
+    // поэтому хеш секции с выравниванием совпадает с хешем выровненного файла.
+    class Checksum {
+    public:
+        void update(const void *data, size_t size) {
+            const char *p = static_cast<const char *>(data);
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                uint64_t w;
+                std::memcpy(&w, p + i, 8);
+                mix(w);
+            }
+            if (i < size) {
+                uint64_t w = 0;
+                std::memcpy(&w, p + i, size - i);
+                mix(w);
+            }
+        }
+
+        uint64_t value() const { return h_; }
+
+    private:
+        uint64_t h_ = 0xcbf29ce484222325ULL;
+
+        void mix(uint64_t w) {
+            h_ = (h_ ^ w) * 0x100000001b3ULL;
+            h_ ^= h_ >> 29;
+        }
+    };
+
+    class SectionWriter {
+    public:
+        explicit SectionWriter(std::ofstream &out) : out_(out) {}
+
+        void write(const void *data, size_t size) {
+            static const char zeros[8] = {};
+            out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            out_.write(zeros, static_cast<std::streamsize>(align8(size) - size));
+            sum_.update(data, size);
+        }
+
+        uint64_t checksum() const { return sum_.value(); }
+
+    private:
+        std::ofstream &out_;
+        Checksum sum_;
+    };
+}// namespace
+
+void GraphSnapshot::save(const Graph &g, const std::string &path) {
+    CsrGraph csr(g);
+    const size_t n = csr.size();
+    const size_t m = csr.edge_count();
+
+    std::vector<uint64_t> name_offsets(n + 1, 0);
+    std::string names;
+    names.reserve(g.names.bytes());
+    for (size_t v = 0; v < n; ++v) {
+        names += g.name(static_cast<int>(v));
+        name_offsets[v + 1] = names.size();
+    }
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        std::string_view na(names.data() + name_offsets[a], name_offsets[a + 1] - name_offsets[a]);
+        std::string_view nb(names.data() + name_offsets[b], name_offsets[b + 1] - name_offsets[b]);
+        return na < nb;
+    });
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create snapshot file: " + path);
+    }
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = sizeof(SnapshotHeader);
+    h.vertices = n;
+    h.edges = m;
+    h.names_bytes = names.size();
+    h.max_weight = csr.max_weight();
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    SectionWriter w(out);
+    w.write(csr.offsets(), (n + 1) * sizeof(uint64_t));
+    w.write(csr.targets(), m * sizeof(int));
+    w.write(csr.weights(), m * sizeof(uint32_t));
+    w.write(name_offsets.data(), name_offsets.size() * sizeof(uint64_t));
+    w.write(order.data(), n * sizeof(int));
+    w.write(names.data(), names.size());
+
+    h.checksum = w.checksum();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write snapshot file: " + path);
+    }
+}
+
+bool GraphSnapshot::is_snapshot(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+GraphSnapshot GraphSnapshot::open(const std::string &path, bool verify) {
+    auto file = std::make_shared<const MappedFile>(path);
+    const char *base = file->data();
+
+    if (file->size() < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+    SnapshotHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a graph snapshot: " + path);
+    }
+    if (h.version < 1 || h.version > VERSION || h.header_size != sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(h.version) + ": " + path);
+    }
+
+    const size_t n = h.vertices, m = h.edges;
+    if (n >= file->size() || m >= file->size() || h.names_bytes >= file->size()) {
+        throw std::runtime_error("Snapshot size does not match its header: " + path);
+    }
+    size_t pos = sizeof(SnapshotHeader);
+    auto section = [&](size_t bytes) {
+        size_t at = pos;
+        pos += align8(bytes);
+        return at;
+    };
+    size_t off_at = section((n + 1) * sizeof(uint64_t));
+    size_t to_at = section(m * sizeof(int));
+    size_t w_at = section(m * sizeof(uint32_t));
+    size_t noff_at = section((n + 1) * sizeof(uint64_t));
+    size_t order_at = section(n * sizeof(int));
+    size_t names_at = section(h.names_bytes);
+
+    if (pos != file->size()) {
+        throw std::runtime_error("Snapshot size does not match its header: " + path);
+    }
+    if (verify) {
+        Checksum sum;
+        sum.update(base + sizeof(SnapshotHeader), file->size() - sizeof(SnapshotHeader));
+        if (sum.value() != h.checksum) {
+            throw std::runtime_error("Snapshot checksum mismatch: " + path);
+        }
+    }
+
+    GraphSnapshot s;
+    // Структурные проверки идут и без контрольной суммы: монотонные
+    // смещения с верными концами и номера вершин в [0, n)
+    auto offsets = reinterpret_cast<const uint64_t *>(base + off_at);
+    s.name_offsets_ = reinterpret_cast<const uint64_t *>(base + noff_at);
+    if (offsets[n] != m || s.name_offsets_[n] != h.names_bytes ||
+        !non_decreasing(offsets, n + 1) || !non_decreasing(s.name_offsets_, n + 1)) {
+        throw std::runtime_error("Corrupted snapshot offsets: " + path);
+    }
+    if (!in_range(reinterpret_cast<const int *>(base + to_at), m, n) ||
+        !in_range(reinterpret_cast<const int *>(base + order_at), n, n)) {
+        throw std::runtime_error("Corrupted snapshot vertex ids: " + path);
+    }
+    auto weights = reinterpret_cast<const uint32_t *>(base + w_at);
+    uint32_t max_weight = static_cast<uint32_t>(h.max_weight);
+    if (h.version == 1) {
+        max_weight = m == 0 ? 0 : *std::max_element(weights, weights + m);
+    } else if (h.max_weight > UINT32_MAX) {
+        throw std::runtime_error("Corrupted snapshot max weight: " + path);
+    }
+    s.csr_ = CsrGraph(file, n, m, offsets,
+                      reinterpret_cast<const int *>(base + to_at),
+                      weights, max_weight);
+    s.name_order_ = reinterpret_cast<const int *>(base + order_at);
+    s.names_ = base + names_at;
+    s.file_ = std::move(file);
+    return s;
+}
+
+std::string_view GraphSnapshot::name(int v) const {
+    return {names_ + name_offsets_[v], static_cast<size_t>(name_offsets_[v + 1] - name_offsets_[v])};
+}
+
+std::optional<int> GraphSnapshot::find_node(std::string_view name_to_find) const {
+    const int *first = name_order_;
+    const int *last = name_order_ + size();
+    const int *it = std::lower_bound(first, last, name_to_find, [&](int v, std::string_view key) {
+        return name(v) < key;
+    });
+    if (it == last || name(*it) != name_to_find) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+Graph GraphSnapshot::to_graph() const {
+    Graph g;
+    const int n = static_cast<int>(size());
+    g.adj.resize(n);
+    g.names.reserve(n, name_offsets_[n]);
+    for (int v = 0; v < n; ++v) {
+        g.names.intern(name(v));
+    }
+
+    const uint64_t *off = csr_.offsets();
+    const int *to = csr_.targets();
+    const uint32_t *wt = csr_.weights();
+    for (int u = 0; u < n; ++u) {
+        g.adj[u].reserve(off[u + 1] - off[u]);
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            g.adj[u].emplace_back(to[e], wt[e]);
+        }
+    }
+    return g;
+}
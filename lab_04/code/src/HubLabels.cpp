@@ -0,0 +1,262 @@
+#include "HubLabels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Config.h"
+#include "IndexedHeap.h"
+#include "MappedFile.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'I', 'U', '7', 'H', 'U', 'B', 'L', 'B'};
+
+    size_t align8(size_t x) {
+        return (x + 7) & ~static_cast<size_t>(7);
+    }
+
+    class LabelArrays {
+    public:
+        std::vector<uint64_t> offsets;
+        std::vector<int> hubs;
+        std::vector<uint64_t> dist;
+
+        HubLabelSet view() const { return {offsets.data(), hubs.data(), dist.data()}; }
+    };
+
+    class OwnedLabels {
+    public:
+        LabelArrays out;
+        LabelArrays in;
+    };
+
+    using Label = std::vector<std::pair<int, uint64_t>>;
+
+    LabelArrays to_csr(const std::vector<Label> &labels) {
+        LabelArrays a;
+        a.offsets.assign(labels.size() + 1, 0);
+        for (size_t v = 0; v < labels.size(); ++v) {
+            a.offsets[v + 1] = a.offsets[v] + labels[v].size();
+        }
+        a.hubs.reserve(a.offsets.back());
+        a.dist.reserve(a.offsets.back());
+        for (const Label &label: labels) {
+            for (auto [h, d]: label) {
+                a.hubs.push_back(h);
+                a.dist.push_back(d);
+            }
+        }
+        return a;
+    }
+
+    void write_section(std::ofstream &out, const void *data, size_t bytes) {
+        static const char zeros[8] = {};
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+        out.write(zeros, static_cast<std::streamsize>(align8(bytes) - bytes));
+    }
+
+    bool labels_valid(const HubLabelSet &s, size_t n, uint64_t entries) {
+        if (s.offsets[0] != 0 || s.offsets[n] != entries) {
+            return false;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (s.offsets[v] > s.offsets[v + 1]) {
+                return false;
+            }
+            for (uint64_t i = s.offsets[v]; i < s.offsets[v + 1]; ++i) {
+                if (s.hubs[i] < 0 || static_cast<size_t>(s.hubs[i]) >= n ||
+                    (i > s.offsets[v] && s.hubs[i] <= s.hubs[i - 1])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}// namespace
+
+HubLabels HubLabels::build(const CsrGraph &g, const std::vector<int> &order) {
+    const size_t n = g.size();
+    std::vector<char> listed(n, 0);
+    for (int v: order) {
+        if (v < 0 || static_cast<size_t>(v) >= n || listed[v]) {
+            throw std::invalid_argument("Hub order must list every vertex exactly once");
+        }
+        listed[v] = 1;
+    }
+    if (order.size() != n) {
+        throw std::invalid_argument("Hub order must list every vertex exactly once");
+    }
+
+    CsrGraph rev = g.reversed();
+    std::vector<Label> out(n), in(n);
+    std::vector<uint64_t> root(n, Config::INF);
+    std::vector<uint64_t> dist(n, Config::INF);
+    std::vector<int> touched;
+    IndexedDaryHeap<Config::HEAP_ARITY> heap(static_cast<int>(n));
+
+    // Дейкстра из r с отсечением: вершина, расстояние до которой уже дают
+    // готовые метки, не получает хаб k и не раскрывается. root[h] — расстояние
+    // между r и хабом h по метке самой r
+    auto pruned_search = [&](const CsrGraph &graph, int r, int k, const Label &root_label, std::vector<Label> &labels) {
+        for (auto [h, d]: root_label) {
+            root[h] = d;
+        }
+        const uint64_t *off = graph.offsets();
+        const int *to = graph.targets();
+        const uint32_t *wt = graph.weights();
+
+        dist[r] = 0;
+        touched.push_back(r);
+        heap.push_or_decrease(r, 0);
+        while (!heap.empty()) {
+            auto [u, d] = heap.pop();
+            bool covered = false;
+            for (auto [h, dh]: labels[u]) {
+                if (root[h] + dh <= d) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) {
+                continue;
+            }
+            labels[u].emplace_back(k, d);
+            for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+                int v = to[e];
+                uint64_t nd = d + wt[e];
+                if (nd < dist[v]) {
+                    if (dist[v] == Config::INF) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = nd;
+                    heap.push_or_decrease(v, nd);
+                }
+            }
+        }
+
+        for (auto [h, d]: root_label) {
+            root[h] = Config::INF;
+        }
+        for (int v: touched) {
+            dist[v] = Config::INF;
+        }
+        touched.clear();
+    };
+
+    for (size_t k = 0; k < n; ++k) {
+        int r = order[k];
+        pruned_search(g, r, static_cast<int>(k), out[r], in);
+        pruned_search(rev, r, static_cast<int>(k), in[r], out);
+    }
+
+    auto owned = std::make_shared<OwnedLabels>();
+    owned->out = to_csr(out);
+    owned->in = to_csr(in);
+
+    HubLabels l;
+    l.n_ = n;
+    l.m_ = g.edge_count();
+    l.max_weight_ = g.max_weight();
+    l.out_ = owned->out.view();
+    l.in_ = owned->in.view();
+    l.owner_ = std::move(owned);
+    return l;
+}
+
+uint64_t HubLabels::distance(int s, int t) const {
+    uint64_t i = out_.offsets[s], ie = out_.offsets[s + 1];
+    uint64_t j = in_.offsets[t], je = in_.offsets[t + 1];
+    uint64_t best = Config::INF;
+    while (i < ie && j < je) {
+        int a = out_.hubs[i], b = in_.hubs[j];
+        if (a < b) {
+            ++i;
+        } else if (b < a) {
+            ++j;
+        } else {
+            best = std::min(best, out_.dist[i] + in_.dist[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return best;
+}
+
+void HubLabels::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create hub label file: " + path);
+    }
+
+    HubHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = sizeof(HubHeader);
+    h.vertices = n_;
+    h.edges = m_;
+    h.max_weight = max_weight_;
+    h.out_entries = out_.offsets[n_];
+    h.in_entries = in_.offsets[n_];
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    for (const HubLabelSet *s: {&out_, &in_}) {
+        const size_t entries = s->offsets[n_];
+        write_section(out, s->offsets, (n_ + 1) * sizeof(uint64_t));
+        write_section(out, s->hubs, entries * sizeof(int));
+        write_section(out, s->dist, entries * sizeof(uint64_t));
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write hub label file: " + path);
+    }
+}
+
+HubLabels HubLabels::open(const std::string &path, const CsrGraph &g) {
+    auto file = std::make_shared<const MappedFile>(path);
+    const char *base = file->data();
+
+    if (file->size() < sizeof(HubHeader)) {
+        throw std::runtime_error("Hub label file is truncated: " + path);
+    }
+    HubHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a hub label file: " + path);
+    }
+    if (h.version != VERSION || h.header_size != sizeof(HubHeader)) {
+        throw std::runtime_error("Unsupported hub label version " + std::to_string(h.version) + ": " + path);
+    }
+    if (h.vertices != g.size() || h.edges != g.edge_count() || h.max_weight != g.max_weight()) {
+        throw std::runtime_error("Hub label file was built for another graph: " + path);
+    }
+
+    const size_t n = h.vertices;
+    if (h.out_entries >= file->size() || h.in_entries >= file->size()) {
+        throw std::runtime_error("Hub label size does not match its header: " + path);
+    }
+    size_t pos = sizeof(HubHeader);
+    auto section = [&](size_t bytes) {
+        const char *at = base + pos;
+        pos += align8(bytes);
+        return at;
+    };
+    HubLabels l;
+    for (auto [set, entries]: {std::pair{&l.out_, h.out_entries}, std::pair{&l.in_, h.in_entries}}) {
+        set->offsets = reinterpret_cast<const uint64_t *>(section((n + 1) * sizeof(uint64_t)));
+        set->hubs = reinterpret_cast<const int *>(section(entries * sizeof(int)));
+        set->dist = reinterpret_cast<const uint64_t *>(section(entries * sizeof(uint64_t)));
+    }
+    if (pos != file->size()) {
+        throw std::runtime_error("Hub label size does not match its header: " + path);
+    }
+    if (!labels_valid(l.out_, n, h.out_entries) || !labels_valid(l.in_, n, h.in_entries)) {
+        throw std::runtime_error("Corrupted hub label file: " + path);
+    }
+
+    l.n_ = n;
+    l.m_ = h.edges;
+    l.max_weight_ = static_cast<uint32_t>(h.max_weight);
+    l.owner_ = std::move(file);
+    return l;
+}
@@ -10,16 +10,31 @@ void JsonResultBuilder::build(const Graph &g,
                               const std::vector<int> &parent,
                               int threads,
                               long long elapsed,
+                              uint64_t settled,
+                              bool use_seq) {
+    auto name_of = [&g](int v) { return g.name(v); };
+    build(name_of, start_name, target_names, target_ids, dist, parent, threads, elapsed, settled, use_seq);
+}
+
+void JsonResultBuilder::build(const NameLookup &name_of,
+                              const std::string &start_name,
+                              const std::vector<std::string> &target_names,
+                              const std::vector<int> &target_ids,
+                              const std::vector<uint64_t> &dist,
+                              const std::vector<int> &parent,
+                              int threads,
+                              long long elapsed,
+                              uint64_t settled,
                               bool use_seq) {
     out_.str("");
     out_.clear();
 
     out_ << "{";
-    build_header(start_name, target_names, threads, elapsed, use_seq);
+    build_header(start_name, target_names, threads, elapsed, settled, use_seq);
     out_ << ",";
     build_distances(target_names, target_ids, dist);
     out_ << ",";
-    build_shortest_path(g, target_names, target_ids, dist, parent);
+    build_shortest_path(name_of, target_names, target_ids, dist, parent);
     out_ << "}";
 }
 
@@ -55,7 +70,7 @@ void JsonResultBuilder::escape_json(const std::string &s) {
 
 void JsonResultBuilder::build_header(const std::string &start_name,
                                      const std::vector<std::string> &target_names,
-                                     int threads, long long elapsed, bool use_seq) {
+                                     int threads, long long elapsed, uint64_t settled, bool use_seq) {
     out_ << "\"start\":\"";
     escape_json(start_name);
     out_ << "\",";
@@ -71,7 +86,8 @@ void JsonResultBuilder::build_header(const std::string &start_name,
 
     out_ << "\"threads\":" << threads << ",";
     out_ << "\"algo\":\"" << (use_seq ? "seq" : "par") << "\",";
-    out_ << "\"time_ms\":" << elapsed;
+    out_ << "\"time_ms\":" << elapsed << ",";
+    out_ << "\"settled\":" << settled;
 }
 
 void JsonResultBuilder::build_distances(const std::vector<std::string> &target_names,
@@ -94,7 +110,7 @@ void JsonResultBuilder::build_distances(const std::vector<std::string> &target_n
     out_ << "}";
 }
 
-void JsonResultBuilder::build_shortest_path(const Graph &g,
+void JsonResultBuilder::build_shortest_path(const NameLookup &name_of,
                                             const std::vector<std::string> &target_names,
                                             const std::vector<int> &target_ids,
                                             const std::vector<uint64_t> &dist,
@@ -115,18 +131,23 @@ void JsonResultBuilder::build_shortest_path(const Graph &g,
         out_ << "null";
     } else {
         int tv = target_ids[best_tid];
-        auto path_idx = reconstruct_path(tv, parent);
 
         out_ << "{\"target\":\"";
         escape_json(target_names[best_tid]);
         out_ << "\",";
-        out_ << "\"distance\":" << dist[tv] << ",";
-        out_ << "\"path\":[";
+        out_ << "\"distance\":" << dist[tv];
+        // Без parent (режим --paths=none) путь не выводится
+        if (parent.empty()) {
+            out_ << "}";
+            return;
+        }
 
+        auto path_idx = reconstruct_path(tv, parent);
+        out_ << ",\"path\":[";
         for (size_t i = 0; i < path_idx.size(); ++i) {
             if (i) out_ << ",";
             out_ << "\"";
-            escape_json(g.idx_to_name[path_idx[i]]);
+            escape_json(name_of(path_idx[i]));
             out_ << "\"";
         }
         out_ << "]}";
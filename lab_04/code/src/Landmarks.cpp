@@ -0,0 +1,182 @@
+#include "Landmarks.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "DijkstraHeap.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'I', 'U', '7', 'L', 'M', 'A', 'R', 'K'};
+
+    size_t align8(size_t x) {
+        return (x + 7) & ~static_cast<size_t>(7);
+    }
+}// namespace
+
+Landmarks Landmarks::build(const CsrGraph &g, int count, int first) {
+    Landmarks l;
+    l.n_ = g.size();
+    l.m_ = g.edge_count();
+    l.max_weight_ = g.max_weight();
+    const size_t n = l.n_;
+    count = static_cast<int>(std::min<size_t>(std::max(count, 0), n));
+    if (count == 0) {
+        return l;
+    }
+
+    CsrGraph rev = g.reversed();
+
+    // Близость к ориентиру — min(d(L, v), d(v, L)): в орграфе ориентир может
+    // оказаться стоком, и тогда прямые расстояния от него ничего не покрывают
+    std::vector<uint64_t> nearest(n, Config::INF);
+    auto cover = [&](const std::vector<uint64_t> &f, const std::vector<uint64_t> &b) {
+        for (size_t v = 0; v < n; ++v) {
+            nearest[v] = std::min({nearest[v], f[v], b[v]});
+        }
+    };
+    // Самая дальняя вершина среди связанных с выбранными
+    auto farthest = [&]() {
+        int best = -1;
+        for (size_t v = 0; v < n; ++v) {
+            if (nearest[v] != Config::INF && (best == -1 || nearest[v] > nearest[best])) {
+                best = static_cast<int>(v);
+            }
+        }
+        return best;
+    };
+
+    std::vector<std::vector<uint64_t>> fwd, bwd;
+    cover(DijkstraHeap(g, first).run().dist, DijkstraHeap(rev, first).run().dist);
+    int next = farthest();
+    while (next != -1 && static_cast<int>(l.ids_.size()) < count &&
+           std::find(l.ids_.begin(), l.ids_.end(), next) == l.ids_.end()) {
+        l.ids_.push_back(next);
+        fwd.push_back(DijkstraHeap(g, next).run().dist);
+        bwd.push_back(DijkstraHeap(rev, next).run().dist);
+        // Стартовая вершина first ориентиром не считается
+        if (l.ids_.size() == 1) {
+            nearest.assign(n, Config::INF);
+        }
+        cover(fwd.back(), bwd.back());
+        next = farthest();
+    }
+
+    const size_t k = l.ids_.size();
+    l.from_.resize(n * k);
+    l.to_.resize(n * k);
+    for (size_t v = 0; v < n; ++v) {
+        for (size_t i = 0; i < k; ++i) {
+            l.from_[v * k + i] = fwd[i][v];
+            l.to_[v * k + i] = bwd[i][v];
+        }
+    }
+    return l;
+}
+
+uint64_t Landmarks::lower_bound(int v, int t) const {
+    const size_t k = count();
+    const uint64_t *fv = from_.data() + static_cast<size_t>(v) * k;
+    const uint64_t *ft = from_.data() + static_cast<size_t>(t) * k;
+    const uint64_t *tv = to_.data() + static_cast<size_t>(v) * k;
+    const uint64_t *tt = to_.data() + static_cast<size_t>(t) * k;
+
+    uint64_t h = 0;
+    for (size_t i = 0; i < k; ++i) {
+        // d(v, t) >= d(L, t) - d(L, v); если L достигает v, но не t, то и v не достигает t
+        if (fv[i] != Config::INF) {
+            if (ft[i] == Config::INF) {
+                return Config::INF;
+            }
+            if (ft[i] > fv[i]) {
+                h = std::max(h, ft[i] - fv[i]);
+            }
+        }
+        // d(v, t) >= d(v, L) - d(t, L); если t достигает L, а v нет, то v не достигает t
+        if (tt[i] != Config::INF) {
+            if (tv[i] == Config::INF) {
+                return Config::INF;
+            }
+            if (tv[i] > tt[i]) {
+                h = std::max(h, tv[i] - tt[i]);
+            }
+        }
+    }
+    return h;
+}
+
+void Landmarks::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create landmarks file: " + path);
+    }
+
+    LandmarkHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = sizeof(LandmarkHeader);
+    h.vertices = n_;
+    h.edges = m_;
+    h.max_weight = max_weight_;
+    h.count = ids_.size();
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    static const char zeros[8] = {};
+    const size_t ids_bytes = ids_.size() * sizeof(int);
+    out.write(reinterpret_cast<const char *>(ids_.data()), static_cast<std::streamsize>(ids_bytes));
+    out.write(zeros, static_cast<std::streamsize>(align8(ids_bytes) - ids_bytes));
+    out.write(reinterpret_cast<const char *>(from_.data()), static_cast<std::streamsize>(from_.size() * sizeof(uint64_t)));
+    out.write(reinterpret_cast<const char *>(to_.data()), static_cast<std::streamsize>(to_.size() * sizeof(uint64_t)));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write landmarks file: " + path);
+    }
+}
+
+Landmarks Landmarks::load(const std::string &path, const CsrGraph &g) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open landmarks file: " + path);
+    }
+
+    LandmarkHeader h{};
+    in.read(reinterpret_cast<char *>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a landmarks file: " + path);
+    }
+    if (h.version != VERSION || h.header_size != sizeof(LandmarkHeader)) {
+        throw std::runtime_error("Unsupported landmarks version " + std::to_string(h.version) + ": " + path);
+    }
+    if (h.vertices != g.size() || h.edges != g.edge_count() || h.max_weight != g.max_weight()) {
+        throw std::runtime_error("Landmarks file was built for another graph: " + path);
+    }
+    if (h.count > h.vertices) {
+        throw std::runtime_error("Corrupted landmarks file: " + path);
+    }
+
+    Landmarks l;
+    l.n_ = g.size();
+    l.m_ = g.edge_count();
+    l.max_weight_ = g.max_weight();
+    const size_t k = h.count;
+    l.ids_.resize(k);
+    l.from_.resize(l.n_ * k);
+    l.to_.resize(l.n_ * k);
+
+    char pad[8];
+    const size_t ids_bytes = k * sizeof(int);
+    in.read(reinterpret_cast<char *>(l.ids_.data()), static_cast<std::streamsize>(ids_bytes));
+    in.read(pad, static_cast<std::streamsize>(align8(ids_bytes) - ids_bytes));
+    in.read(reinterpret_cast<char *>(l.from_.data()), static_cast<std::streamsize>(l.from_.size() * sizeof(uint64_t)));
+    in.read(reinterpret_cast<char *>(l.to_.data()), static_cast<std::streamsize>(l.to_.size() * sizeof(uint64_t)));
+    if (!in || in.peek() != std::char_traits<char>::eof()) {
+        throw std::runtime_error("Landmarks file size does not match its header: " + path);
+    }
+    for (int id: l.ids_) {
+        if (id < 0 || static_cast<size_t>(id) >= l.n_) {
+            throw std::runtime_error("Corrupted landmarks file: " + path);
+        }
+    }
+    return l;
+}
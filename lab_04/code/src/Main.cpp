@@ -1,25 +1,45 @@
 // Main.cpp (модифицированная версия)
 #include "ArgsParser.h"
 #include "Config.h"
+#include "ContractionHierarchy.h"
+#include "CsrGraph.h"
+#include "DijkstraAlt.h"
+#include "DijkstraBidir.h"
+#include "DijkstraBucket.h"
+#include "DijkstraCh.h"
+#include "DijkstraDense.h"
+#include "DijkstraDelta.h"
+#include "DijkstraHeap.h"
+#include "DijkstraHub.h"
 #include "DijkstraPar.h"
 #include "DijkstraSeq.h"
 #include "Experiments.h"// Добавляем заголовок экспериментов
 #include "Graph.h"
+#include "GraphPartition.h"
+#include "GraphSnapshot.h"
+#include "HubLabels.h"
 #include "JsonResultBuilder.h"
+#include "Landmarks.h"
+#include "NearestTargets.h"
+#include "PathRecovery.h"
 #include "Timer.h"
+#include "VertexOrder.h"
 
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <string>
 #include <vector>
 
-static std::vector<int> map_targets(const Graph &g, const std::vector<std::string> &names) {
+template<typename Lookup>
+static std::vector<int> map_targets(const Lookup &find_node, const std::vector<std::string> &names) {
     std::vector<int> ids;
     ids.reserve(names.size());
     for (const auto &n: names) {
-        auto id = g.find_node(n);
+        auto id = find_node(n);
         if (!id) {
             throw std::runtime_error("Target node not found: " + n);
         }
@@ -28,6 +48,50 @@ static std::vector<int> map_targets(const Graph &g, const std::vector<std::strin
     return ids;
 }
 
+// Индексы (ориентиры ALT, иерархия CH, метки хабов) хранятся рядом с файлом графа
+// (<имя><ext>) и перестраиваются, если файл старше графа, построен для другого
+// графа или не подходит по параметрам (load возвращает nullopt)
+template<typename Index, typename Load, typename Build>
+static Index load_index_cached(const std::string &graph_file, const std::string &ext, Load load, Build build) {
+    std::filesystem::path path = std::filesystem::path(graph_file).replace_extension(ext);
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec) &&
+        std::filesystem::last_write_time(path, ec) >= std::filesystem::last_write_time(graph_file, ec)) {
+        try {
+            std::optional<Index> index = load(path.string());
+            if (index) {
+                return std::move(*index);
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Индекс " << path << " не прочитан: " << e.what() << std::endl;
+        }
+    }
+
+    Index index = build();
+    try {
+        index.save(path.string());
+    } catch (const std::exception &e) {
+        std::cerr << "Не удалось сохранить индекс " << path << ": " << e.what() << std::endl;
+    }
+    return index;
+}
+
+// Режим --paths=lazy: parent восстанавливается только вдоль пути до ближайшей
+// цели (его и выводит JsonResultBuilder)
+static void recover_nearest_path(const CsrGraph &reverse, int start, const std::vector<int> &targets,
+                                 const std::vector<uint64_t> &dist, std::vector<int> &parent) {
+    int nearest = -1;
+    for (int t: targets) {
+        if (nearest == -1 || dist[t] < dist[nearest]) {
+            nearest = t;
+        }
+    }
+    std::vector<int> path = recover_path(reverse, start, nearest, [&](int v) { return dist[v]; });
+    for (size_t j = 1; j < path.size(); ++j) {
+        parent[path[j]] = path[j - 1];
+    }
+}
+
 static std::string json_escape(const std::string &s) {
     std::string o;
     o.reserve(s.size() + 8);
@@ -66,13 +130,29 @@ static void print_error_json(const std::string &msg) {
 
 static void print_usage() {
     std::cout << "Usage:" << std::endl;
-    std::cout << "  Основной режим: lab04 <input.dot> <start> <targets_csv> <threads>" << std::endl;
+    std::cout << "  Основной режим: lab04 <input.dot> <start> <targets_csv> <threads> [--engine=linear|dense|heap|bucket|bidir|alt|ch|hub|nearest|parallel|delta] [--landmarks=K] [--paths=parents|lazy|none] [--reorder=bfs|rcm|degree] [--partition] [--verify]" << std::endl;
     std::cout << "  Эксперименты:   lab04 -e" << std::endl;
+    std::cout << "  Загрузка DOT:   lab04 -p <input.dot> [runs] [threads]" << std::endl;
+    std::cout << "  Движки:         lab04 -b [runs]" << std::endl;
+    std::cout << "  MultiQueue:     lab04 -q [runs]" << std::endl;
+    std::cout << "  Пул потоков:    lab04 -w [queries]" << std::endl;
+    std::cout << "  Много истоков:  lab04 -s [runs]" << std::endl;
+    std::cout << "  Ближайшая цель: lab04 -m [queries]" << std::endl;
+    std::cout << "  Перенумерация:  lab04 -r [runs]" << std::endl;
+    std::cout << "  Владельцы:      lab04 -o [runs]" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  lab04 graph.dot A \"X,Y,Z\" 4" << std::endl;
     std::cout << "  lab04 graph.dot \"Node A\" \"Target 1,Target 2\" 0" << std::endl;
     std::cout << "  lab04 -e  # запуск сравнительных экспериментов" << std::endl;
+    std::cout << "  lab04 -p graph.dot 5  # скорость разбора DOT (МБ/с, дуг/с)" << std::endl;
+    std::cout << "  lab04 -b 3  # линейный поиск минимума против кучи и корзин на разреженных и плотных графах" << std::endl;
+    std::cout << "  lab04 -q 3  # время, ошибка ранга и доля пустых извлечений MultiQueue по c и потокам" << std::endl;
+    std::cout << "  lab04 -w 500  # накладные расходы запроса: новые потоки против постоянного пула" << std::endl;
+    std::cout << "  lab04 -s 3  # поиск из 4-16 истоков: по одному против векторной группы" << std::endl;
+    std::cout << "  lab04 -m 200  # таблица ближайших целей: построение и запросы против поиска на каждый запрос" << std::endl;
+    std::cout << "  lab04 -r 3  # порядки bfs, rcm, degree: время поиска и промахи кэша" << std::endl;
+    std::cout << "  lab04 -o 3  # параллельный движок: случайные очереди против разбиения, разрез и доля чужих вставок" << std::endl;
 }
 
 int main(int argc, char **argv) {
@@ -83,6 +163,103 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    if (argc >= 3 && std::string(argv[1]) == "-p") {
+        try {
+            int runs = argc >= 4 ? std::max(1, std::stoi(argv[3])) : 5;
+            int load_threads = argc >= 5 ? std::stoi(argv[4]) : 0;
+            ExperimentRunner runner;
+            runner.run_load_benchmark(argv[2], runs, load_threads);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        try {
+            int runs = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 3;
+            ExperimentRunner runner;
+            runner.run_engine_benchmark(runs);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-q") {
+        try {
+            int runs = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 3;
+            ExperimentRunner runner;
+            runner.run_scheduler_benchmark(runs);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-w") {
+        try {
+            int queries = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 500;
+            ExperimentRunner runner;
+            runner.run_pool_benchmark(queries);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-s") {
+        try {
+            int runs = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 3;
+            ExperimentRunner runner;
+            runner.run_batch_benchmark(runs);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-m") {
+        try {
+            int queries = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 200;
+            ExperimentRunner runner;
+            runner.run_nearest_benchmark(queries);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-r") {
+        try {
+            int runs = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 3;
+            ExperimentRunner runner;
+            runner.run_reorder_benchmark(runs);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-o") {
+        try {
+            int runs = argc >= 3 ? std::max(1, std::stoi(argv[2])) : 3;
+            ExperimentRunner runner;
+            runner.run_partition_benchmark(runs);
+            return 0;
+        } catch (const std::exception &e) {
+            print_error_json(e.what());
+            return 1;
+        }
+    }
+
     try {
         if (argc < 2) {
             print_usage();
@@ -91,39 +268,239 @@ int main(int argc, char **argv) {
 
         ProgramArgs args = ArgsParser::parse(argc, argv);
 
-        Graph g = Graph::load_from_dot(args.input_file);
+        // Бинарный снимок используется на месте (mmap), DOT разбирается
+        Graph g;
+        CsrGraph own_csr;
+        std::optional<GraphSnapshot> snap;
+        if (GraphSnapshot::is_snapshot(args.input_file)) {
+            snap = GraphSnapshot::open(args.input_file, args.verify);
+        } else {
+            g = args.threads > 0 ? Graph::load_from_dot_parallel(args.input_file, args.threads)
+                                 : Graph::load_from_dot(args.input_file);
+            own_csr = CsrGraph(g);
+        }
+        const CsrGraph &loaded = snap ? snap->csr() : own_csr;
+
+        // --reorder: движки работают в новых номерах, результат переводится
+        // обратно перед выводом (name_of принимает исходные номера)
+        std::optional<VertexOrder> order;
+        CsrGraph reordered;
+        if (!args.reorder.empty()) {
+            order = VertexOrder::compute(loaded, VertexOrder::parse(args.reorder));
+            reordered = loaded.permuted(order->order());
+        }
+        const CsrGraph &csr = order ? reordered : loaded;
+        // Индексы перенумерованного графа кэшируются отдельно: <имя>.<порядок><ext>
+        auto index_ext = [&](const char *ext) { return order ? "." + args.reorder + ext : std::string(ext); };
+
+        auto find_node = [&](const std::string &name) -> std::optional<int> {
+            std::optional<int> id = snap ? snap->find_node(name) : g.find_node(name);
+            if (id && order) {
+                return order->to_new(*id);
+            }
+            return id;
+        };
+        auto name_of = [&](int v) -> std::string {
+            return snap ? std::string(snap->name(v)) : g.name(v);
+        };
 
-        auto start_id_opt = g.find_node(args.start_node);
+        auto start_id_opt = find_node(args.start_node);
         if (!start_id_opt) {
             print_error_json("start node not found: " + args.start_node);
             return 1;
         }
         int start = *start_id_opt;
-        auto target_ids = map_targets(g, args.target_nodes);
+        auto target_ids = map_targets(find_node, args.target_nodes);
 
-        bool use_seq = (args.threads == 0);
+        bool use_seq = args.engine != "parallel" && args.engine != "delta";
+        // Линейный, плотный и параллельный движки умеют считать только расстояния;
+        // прочие пишут parent всегда
+        const bool record_parents = args.paths == "parents";
+        const bool lazy = args.paths == "lazy";
+        std::optional<CsrGraph> reverse;
+        if (lazy && (args.engine == "linear" || args.engine == "dense" || args.engine == "parallel")) {
+            reverse = csr.reversed();
+        }
         std::vector<uint64_t> dist;
         std::vector<int> parent;
+        uint64_t settled;
         long long elapsed;
 
-        if (use_seq) {
-            DijkstraSequential seq(g, start);
+        if (args.engine == "dense") {
+            // Матрица строится до замера, как обратный граф у bidir
+            DenseGraph dense(csr);
+            DijkstraDense engine(dense, start);
+            engine.set_targets(target_ids);
+            engine.set_record_parents(record_parents);
+            Timer t;
+            auto r = engine.run();
+            if (reverse) {
+                recover_nearest_path(*reverse, start, target_ids, r.dist, r.parent);
+            }
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "heap") {
+            DijkstraHeap heap(csr, start);
+            heap.set_targets(target_ids);
+            Timer t;
+            auto r = heap.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "bucket") {
+            DijkstraBucket bucket(csr, start);
+            bucket.set_targets(target_ids);
+            Timer t;
+            auto r = bucket.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "bidir") {
+            DijkstraBidirectional bidir(csr, start);
+            bidir.set_targets(target_ids);
+            bidir.prepare();
+            Timer t;
+            auto r = bidir.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "alt") {
+            Landmarks landmarks = load_index_cached<Landmarks>(
+                    args.input_file, index_ext(".alt"),
+                    [&](const std::string &path) -> std::optional<Landmarks> {
+                        Landmarks l = Landmarks::load(path, csr);
+                        if (l.count() < std::min<size_t>(args.landmarks, csr.size())) {
+                            return std::nullopt;
+                        }
+                        return l;
+                    },
+                    [&] { return Landmarks::build(csr, args.landmarks); });
+            DijkstraAlt alt(csr, landmarks, start);
+            alt.set_targets(target_ids);
+            Timer t;
+            auto r = alt.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "ch") {
+            ContractionHierarchy ch = load_index_cached<ContractionHierarchy>(
+                    args.input_file, index_ext(".ch"),
+                    [&](const std::string &path) { return std::optional(ContractionHierarchy::load(path, csr)); },
+                    [&] { return ContractionHierarchy::build(csr); });
+            DijkstraCh query(ch, start);
+            query.set_targets(target_ids);
+            Timer t;
+            auto r = query.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "hub") {
+            // Метки строятся в порядке рангов CH; иерархия тоже берётся из кэша
+            HubLabels labels = load_index_cached<HubLabels>(
+                    args.input_file, index_ext(".hub"),
+                    [&](const std::string &path) { return std::optional(HubLabels::open(path, csr)); },
+                    [&] {
+                        ContractionHierarchy ch = load_index_cached<ContractionHierarchy>(
+                                args.input_file, index_ext(".ch"),
+                                [&](const std::string &path) { return std::optional(ContractionHierarchy::load(path, csr)); },
+                                [&] { return ContractionHierarchy::build(csr); });
+                        return HubLabels::build(csr, ch.order());
+                    });
+            DijkstraHub query(labels, csr, start);
+            query.set_targets(target_ids);
+            query.prepare();
+            Timer t;
+            auto r = query.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (args.engine == "nearest") {
+            // Таблица зависит только от целей: файл другого списка целей перестраивается
+            NearestTargets table = load_index_cached<NearestTargets>(
+                    args.input_file, index_ext(".near"),
+                    [&](const std::string &path) -> std::optional<NearestTargets> {
+                        NearestTargets t = NearestTargets::load(path, csr);
+                        if (!t.built_for(target_ids)) {
+                            return std::nullopt;
+                        }
+                        return t;
+                    },
+                    [&] { return NearestTargets::build(csr, target_ids); });
+            Timer t;
+            std::vector<int> path = table.path(start);
+            elapsed = t.us();
+            // Расстояния до прочих целей неизвестны и выводятся как null
+            dist.assign(csr.size(), std::numeric_limits<uint64_t>::max());
+            parent.assign(csr.size(), -1);
+            if (!path.empty()) {
+                dist[path.back()] = table.distance(start);
+                for (size_t j = 1; j < path.size(); ++j) {
+                    parent[path[j]] = path[j - 1];
+                }
+            }
+            settled = path.size();
+        } else if (args.engine == "delta") {
+            DijkstraDelta delta(csr, start, args.threads);
+            delta.set_targets(target_ids);
+            delta.prepare();
+            Timer t;
+            auto r = delta.run();
+            elapsed = t.us();
+            dist = std::move(r.dist);
+            parent = std::move(r.parent);
+            settled = r.settled;
+        } else if (use_seq) {
+            DijkstraSequential seq(csr, start);
+            seq.set_targets(target_ids);
+            seq.set_record_parents(record_parents);
             Timer t;
             auto r = seq.run();
+            if (reverse) {
+                recover_nearest_path(*reverse, start, target_ids, r.dist, r.parent);
+            }
             elapsed = t.us();
             dist = std::move(r.dist);
             parent = std::move(r.parent);
+            settled = r.settled;
         } else {
-            DijkstraParallel par(g, start, args.threads);
+            DijkstraParallel par(csr, start, args.threads);
+            par.set_targets(target_ids);
+            par.set_record_parents(record_parents);
+            if (args.partition) {
+                // Разбиение — предобработка графа, в замер не входит
+                par.set_partition(std::make_shared<GraphPartition>(GraphPartition::build(csr, args.threads)));
+            }
             Timer t;
             auto r = par.run();
+            if (reverse) {
+                recover_nearest_path(*reverse, start, target_ids, r.dist, r.parent);
+            }
             elapsed = t.us();
             dist = std::move(r.dist);
             parent = std::move(r.parent);
+            settled = r.settled;
+        }
+
+        if (order) {
+            order->restore(dist, parent);
+            for (int &t: target_ids) {
+                t = order->to_old(t);
+            }
+        }
+        if (args.paths == "none") {
+            parent.clear();
         }
 
         JsonResultBuilder builder;
-        builder.build(g, args.start_node, args.target_nodes, target_ids, dist, parent, args.threads, elapsed, use_seq);
+        builder.build(name_of, args.start_node, args.target_nodes, target_ids, dist, parent, args.threads, elapsed, settled, use_seq);
 
         std::cout << builder.get_result() << std::endl;
         return 0;
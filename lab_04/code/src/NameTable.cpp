@@ -0,0 +1,189 @@
+#include "NameTable.h"
+
+#include <algorithm>
+#include <functional>
+
+std::optional<uint32_t> NameTable::parse_decimal(std::string_view name) {
+    // Только каноническая запись: без знака и ведущих нулей, не длиннее 9 цифр
+    if (name.empty() || name.size() > 9 || (name[0] == '0' && name.size() > 1)) {
+        return std::nullopt;
+    }
+    uint32_t v = 0;
+    for (char c: name) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        v = v * 10 + static_cast<uint32_t>(c - '0');
+    }
+    return v;
+}
+
+uint32_t NameTable::hash_of(std::string_view name) {
+    uint64_t h = std::hash<std::string_view>{}(name);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+int NameTable::intern(std::string_view name) {
+    if (mode_ != Mode::Strings) {
+        auto v = parse_decimal(name);
+        if (v) {
+            int idx = intern_numeric(*v);
+            if (idx >= 0) {
+                return idx;
+            }
+        }
+        to_strings();
+    }
+    return intern_string(name);
+}
+
+int NameTable::intern_numeric(uint32_t value) {
+    if (mode_ == Mode::Dense) {
+        if (value < count_) {
+            return static_cast<int>(value);
+        }
+        if (value == count_) {
+            return static_cast<int>(count_++);
+        }
+        to_numeric();
+    }
+
+    // Слишком разреженные номера хранить массивом невыгодно
+    if (value >= std::max<size_t>(1024, 4 * (count_ + 1))) {
+        return -1;
+    }
+    if (value >= value_to_idx_.size()) {
+        value_to_idx_.resize(std::max<size_t>(value + 1, value_to_idx_.size() * 2), -1);
+    }
+    int &idx = value_to_idx_[value];
+    if (idx < 0) {
+        idx = static_cast<int>(count_++);
+        idx_to_value_.push_back(value);
+    }
+    return idx;
+}
+
+int NameTable::intern_string(std::string_view name) {
+    if ((count_ + 1) * 2 > slots_.size()) {
+        rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    }
+
+    const uint32_t h = hash_of(name);
+    for (size_t pos = h & mask_;; pos = (pos + 1) & mask_) {
+        Slot &s = slots_[pos];
+        if (s.idx < 0) {
+            s.hash = h;
+            s.idx = static_cast<int>(count_++);
+            arena_.append(name);
+            offsets_.push_back(arena_.size());
+            return s.idx;
+        }
+        if (s.hash == h && stored(s.idx) == name) {
+            return s.idx;
+        }
+    }
+}
+
+std::optional<int> NameTable::find(std::string_view name) const {
+    if (mode_ != Mode::Strings) {
+        auto v = parse_decimal(name);
+        if (!v) {
+            return std::nullopt;
+        }
+        if (mode_ == Mode::Dense) {
+            return *v < count_ ? std::optional<int>(static_cast<int>(*v)) : std::nullopt;
+        }
+        if (*v >= value_to_idx_.size() || value_to_idx_[*v] < 0) {
+            return std::nullopt;
+        }
+        return value_to_idx_[*v];
+    }
+
+    if (slots_.empty()) {
+        return std::nullopt;
+    }
+
+    const uint32_t h = hash_of(name);
+    for (size_t pos = h & mask_;; pos = (pos + 1) & mask_) {
+        const Slot &s = slots_[pos];
+        if (s.idx < 0) {
+            return std::nullopt;
+        }
+        if (s.hash == h && stored(s.idx) == name) {
+            return s.idx;
+        }
+    }
+}
+
+std::string NameTable::name(int idx) const {
+    switch (mode_) {
+        case Mode::Dense:
+            return std::to_string(idx);
+        case Mode::Numeric:
+            return std::to_string(idx_to_value_[idx]);
+        default:
+            return std::string(stored(idx));
+    }
+}
+
+void NameTable::to_numeric() {
+    value_to_idx_.resize(std::max<size_t>(count_ * 2, 1024), -1);
+    idx_to_value_.resize(count_);
+    for (size_t i = 0; i < count_; ++i) {
+        value_to_idx_[i] = static_cast<int>(i);
+        idx_to_value_[i] = static_cast<uint32_t>(i);
+    }
+    mode_ = Mode::Numeric;
+}
+
+void NameTable::to_strings() {
+    // Материализуем уже выданные числовые имена в арену
+    const size_t n = count_;
+    std::vector<std::string> names(n);
+    for (size_t i = 0; i < n; ++i) {
+        names[i] = name(static_cast<int>(i));
+    }
+
+    value_to_idx_ = {};
+    idx_to_value_ = {};
+    mode_ = Mode::Strings;
+    count_ = 0;
+    for (const auto &s: names) {
+        intern_string(s);
+    }
+}
+
+void NameTable::reserve(size_t names, size_t bytes) {
+    if (mode_ != Mode::Strings) {
+        return;
+    }
+    arena_.reserve(bytes);
+    offsets_.reserve(names + 1);
+    size_t capacity = 16;
+    while (capacity < names * 2) {
+        capacity *= 2;
+    }
+    if (capacity > slots_.size()) {
+        rehash(capacity);
+    }
+}
+
+void NameTable::clear() {
+    *this = NameTable();
+}
+
+void NameTable::rehash(size_t capacity) {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot{0, -1});
+    mask_ = capacity - 1;
+    for (const Slot &s: old) {
+        if (s.idx < 0) {
+            continue;
+        }
+        size_t pos = s.hash & mask_;
+        while (slots_[pos].idx >= 0) {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos] = s;
+    }
+}
@@ -0,0 +1,195 @@
+#include "NearestTargets.h"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+#include "Config.h"
+
+namespace {
+    constexpr char MAGIC[8] = {'I', 'U', '7', 'N', 'E', 'A', 'R', 'T'};
+
+    size_t align8(size_t x) {
+        return (x + 7) & ~static_cast<size_t>(7);
+    }
+
+    std::vector<int> unique_in_order(const std::vector<int> &targets, size_t n) {
+        std::vector<int> out;
+        std::vector<bool> seen(n, false);
+        for (int t: targets) {
+            if (t < 0 || static_cast<size_t>(t) >= n) {
+                throw std::invalid_argument("Target out of range: " + std::to_string(t));
+            }
+            if (!seen[t]) {
+                seen[t] = true;
+                out.push_back(t);
+            }
+        }
+        return out;
+    }
+}// namespace
+
+NearestTargets NearestTargets::build(const CsrGraph &g, const std::vector<int> &targets) {
+    NearestTargets table;
+    table.n_ = g.size();
+    table.m_ = g.edge_count();
+    table.max_weight_ = g.max_weight();
+    table.targets_ = unique_in_order(targets, table.n_);
+
+    const size_t n = table.n_;
+    table.dist_.assign(n, Config::INF);
+    table.nearest_.assign(n, -1);
+    table.next_.assign(n, -1);
+    // Номер цели в списке: метка вершины — пара (расстояние, номер), поэтому
+    // при равенстве расстояний побеждает цель, стоящая раньше
+    std::vector<int> rank(n, -1);
+
+    // (dist, rank, v); устаревшие записи отбрасываются при извлечении
+    using Item = std::tuple<uint64_t, int, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+    for (size_t i = 0; i < table.targets_.size(); ++i) {
+        const int t = table.targets_[i];
+        table.dist_[t] = 0;
+        table.nearest_[t] = t;
+        rank[t] = static_cast<int>(i);
+        pq.push({0, rank[t], t});
+    }
+
+    CsrGraph rev = g.reversed();
+    const uint64_t *off = rev.offsets();
+    const int *from = rev.targets();
+    const uint32_t *wt = rev.weights();
+    while (!pq.empty()) {
+        auto [d, r, u] = pq.top();
+        pq.pop();
+        if (d != table.dist_[u] || r != rank[u]) {
+            continue;
+        }
+        // Обратная дуга u -> v — это дуга v -> u исходного графа
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            const int v = from[e];
+            const uint64_t nd = d + wt[e];
+            if (nd < table.dist_[v] || (nd == table.dist_[v] && r < rank[v])) {
+                table.dist_[v] = nd;
+                rank[v] = r;
+                table.nearest_[v] = table.nearest_[u];
+                table.next_[v] = u;
+                pq.push({nd, r, v});
+            }
+        }
+    }
+    return table;
+}
+
+bool NearestTargets::built_for(const std::vector<int> &targets) const {
+    for (int t: targets) {
+        if (t < 0 || static_cast<size_t>(t) >= n_) {
+            return false;
+        }
+    }
+    return unique_in_order(targets, n_) == targets_;
+}
+
+std::vector<int> NearestTargets::path(int v) const {
+    if (nearest_[v] == -1) {
+        return {};
+    }
+    std::vector<int> out;
+    for (; v != -1; v = next_[v]) {
+        // Цикл в ссылках возможен только в испорченном файле
+        if (out.size() == n_) {
+            throw std::runtime_error("Nearest targets table has a cycle");
+        }
+        out.push_back(v);
+    }
+    return out;
+}
+
+void NearestTargets::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to create nearest targets file: " + path);
+    }
+
+    NearestHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = sizeof(NearestHeader);
+    h.vertices = n_;
+    h.edges = m_;
+    h.max_weight = max_weight_;
+    h.count = targets_.size();
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    static const char zeros[8] = {};
+    const size_t targets_bytes = targets_.size() * sizeof(int);
+    out.write(reinterpret_cast<const char *>(targets_.data()), static_cast<std::streamsize>(targets_bytes));
+    out.write(zeros, static_cast<std::streamsize>(align8(targets_bytes) - targets_bytes));
+    out.write(reinterpret_cast<const char *>(dist_.data()), static_cast<std::streamsize>(n_ * sizeof(uint64_t)));
+    out.write(reinterpret_cast<const char *>(nearest_.data()), static_cast<std::streamsize>(n_ * sizeof(int)));
+    out.write(reinterpret_cast<const char *>(next_.data()), static_cast<std::streamsize>(n_ * sizeof(int)));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write nearest targets file: " + path);
+    }
+}
+
+NearestTargets NearestTargets::load(const std::string &path, const CsrGraph &g) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open nearest targets file: " + path);
+    }
+
+    NearestHeader h{};
+    in.read(reinterpret_cast<char *>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a nearest targets file: " + path);
+    }
+    if (h.version != VERSION || h.header_size != sizeof(NearestHeader)) {
+        throw std::runtime_error("Unsupported nearest targets version " + std::to_string(h.version) + ": " + path);
+    }
+    if (h.vertices != g.size() || h.edges != g.edge_count() || h.max_weight != g.max_weight()) {
+        throw std::runtime_error("Nearest targets file was built for another graph: " + path);
+    }
+    if (h.count > h.vertices) {
+        throw std::runtime_error("Corrupted nearest targets file: " + path);
+    }
+
+    NearestTargets table;
+    table.n_ = g.size();
+    table.m_ = g.edge_count();
+    table.max_weight_ = g.max_weight();
+    const size_t n = table.n_;
+    table.targets_.resize(h.count);
+    table.dist_.resize(n);
+    table.nearest_.resize(n);
+    table.next_.resize(n);
+
+    char pad[8];
+    const size_t targets_bytes = h.count * sizeof(int);
+    in.read(reinterpret_cast<char *>(table.targets_.data()), static_cast<std::streamsize>(targets_bytes));
+    in.read(pad, static_cast<std::streamsize>(align8(targets_bytes) - targets_bytes));
+    in.read(reinterpret_cast<char *>(table.dist_.data()), static_cast<std::streamsize>(n * sizeof(uint64_t)));
+    in.read(reinterpret_cast<char *>(table.nearest_.data()), static_cast<std::streamsize>(n * sizeof(int)));
+    in.read(reinterpret_cast<char *>(table.next_.data()), static_cast<std::streamsize>(n * sizeof(int)));
+    if (!in || in.peek() != std::char_traits<char>::eof()) {
+        throw std::runtime_error("Nearest targets file size does not match its header: " + path);
+    }
+
+    // Ссылки проверяются заранее, чтобы path не вышел за массивы
+    auto in_range = [n](int v) { return v >= -1 && static_cast<int64_t>(v) < static_cast<int64_t>(n); };
+    for (int t: table.targets_) {
+        if (t < 0 || !in_range(t)) {
+            throw std::runtime_error("Corrupted nearest targets file: " + path);
+        }
+    }
+    for (size_t v = 0; v < n; ++v) {
+        if (!in_range(table.nearest_[v]) || !in_range(table.next_[v])) {
+            throw std::runtime_error("Corrupted nearest targets file: " + path);
+        }
+    }
+    return table;
+}
@@ -0,0 +1,61 @@
+#include "PathRecovery.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "Config.h"
+
+std::vector<int> recover_path(const CsrGraph &reverse, int start, int target,
+                              const std::function<uint64_t(int)> &dist) {
+    if (dist(target) >= Config::INF) {
+        return {};
+    }
+
+    const uint64_t *off = reverse.offsets();
+    const int *from = reverse.targets();
+    const uint32_t *wt = reverse.weights();
+
+    class Step {
+    public:
+        int v;
+        uint64_t dist;
+        uint64_t next;// следующая входящая дуга v для проверки
+    };
+
+    // Поиск в глубину по подходящим предкам: при дугах нулевого веса первый
+    // подходящий предок может завести в цикл или тупик, тогда шаг откатывается
+    std::vector<Step> stack{{target, dist(target), off[target]}};
+    std::unordered_set<int> seen{target};
+    while (!stack.empty() && stack.back().v != start) {
+        Step &s = stack.back();
+        bool advanced = false;
+        while (s.next < off[s.v + 1]) {
+            uint64_t e = s.next++;
+            int p = from[e];
+            if (wt[e] > s.dist || seen.count(p)) {
+                continue;
+            }
+            uint64_t dp = dist(p);
+            if (dp + wt[e] == s.dist) {
+                seen.insert(p);
+                stack.push_back({p, dp, off[p]});
+                advanced = true;
+                break;
+            }
+        }
+        if (!advanced) {
+            stack.pop_back();
+        }
+    }
+    if (stack.empty()) {
+        throw std::runtime_error("Distances do not match the graph");
+    }
+
+    std::vector<int> path;
+    path.reserve(stack.size());
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+        path.push_back(it->v);
+    }
+    return path;
+}
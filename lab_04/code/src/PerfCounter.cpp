@@ -0,0 +1,53 @@
+#include "PerfCounter.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+PerfCounter::PerfCounter() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounter::~PerfCounter() {
+    if (fd_ != -1) {
+        close(fd_);
+    }
+}
+
+void PerfCounter::start() {
+    if (fd_ != -1) {
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+long long PerfCounter::stop() {
+    if (fd_ == -1) {
+        return -1;
+    }
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        return -1;
+    }
+    return count;
+}
+#else
+PerfCounter::PerfCounter() = default;
+PerfCounter::~PerfCounter() = default;
+void PerfCounter::start() {}
+long long PerfCounter::stop() {
+    return -1;
+}
+#endif
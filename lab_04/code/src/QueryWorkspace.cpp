@@ -0,0 +1,61 @@
+#include "QueryWorkspace.h"
+
+#include <algorithm>
+
+void QueryWorkspace::begin(size_t n, bool parents) {
+    // Эпоха 0 — «никогда», BUSY занята протоколом захвата
+    if (n != size() || epoch_ + 1 >= BUSY) {
+        dist_.assign(n, Config::INF);
+        parent_.assign(n, -1);
+        stamp_.assign(n, 0);
+        done_.assign(n, 0);
+        epoch_ = 0;
+    }
+    ++epoch_;
+    packed_mode_ = false;
+    parents_ = parents;
+    parent_bits_ = 0;
+}
+
+void QueryWorkspace::begin_packed(size_t n, uint64_t dist_bound, bool parents) {
+    begin(n, parents);
+    int bits = 0;// без родителей слово — только расстояние
+    if (parents) {
+        if (dist_bound < (uint64_t{1} << 32) - 1) {
+            bits = 32;
+        } else if (n < (uint64_t{1} << 24) - 1 && dist_bound < (uint64_t{1} << 40) - 1) {
+            bits = 24;
+        } else {
+            return;
+        }
+    }
+    // Без обнуления при выделении: слова очищает reset
+    if (packed_size_ != n) {
+        packed_.reset(new uint64_t[n]);
+        packed_size_ = n;
+    }
+    packed_mode_ = true;
+    parent_bits_ = bits;
+    parent_mask_ = (uint64_t{1} << bits) - 1;
+    empty_ = ~uint64_t{0};
+}
+
+void QueryWorkspace::reset(size_t lo, size_t hi) {
+    std::fill(packed_.get() + lo, packed_.get() + hi, empty_);
+}
+
+std::vector<uint64_t> QueryView::dist_vector() const {
+    std::vector<uint64_t> d(size());
+    for (size_t v = 0; v < d.size(); ++v) {
+        d[v] = dist(static_cast<int>(v));
+    }
+    return d;
+}
+
+std::vector<int> QueryView::parent_vector() const {
+    std::vector<int> p(size());
+    for (size_t v = 0; v < p.size(); ++v) {
+        p[v] = parent(static_cast<int>(v));
+    }
+    return p;
+}
@@ -0,0 +1,89 @@
+#include "WorkerPool.h"
+
+#include <stdexcept>
+
+WorkerPool::WorkerPool(int threads) {
+    resize(threads);
+}
+
+WorkerPool::~WorkerPool() {
+    stop_workers();
+}
+
+void WorkerPool::resize(int threads) {
+    if (threads < 1) {
+        throw std::invalid_argument("Worker pool size must be positive");
+    }
+    if (threads == size()) {
+        return;
+    }
+    stop_workers();
+    workers_.reserve(threads - 1);
+    for (int idx = 1; idx < threads; ++idx) {
+        workers_.emplace_back(&WorkerPool::loop, this, idx, generation_);
+    }
+}
+
+void WorkerPool::run(const std::function<void(int)> &job) {
+    if (workers_.empty()) {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_);
+        job_ = &job;
+        pending_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    // Рабочие держат ссылку на job, поэтому ждём их и при исключении в job(0)
+    auto wait_workers = [this]() {
+        std::unique_lock<std::mutex> lk(m_);
+        idle_.wait(lk, [this]() { return pending_ == 0; });
+        job_ = nullptr;
+    };
+    try {
+        job(0);
+    } catch (...) {
+        wait_workers();
+        throw;
+    }
+    wait_workers();
+}
+
+void WorkerPool::loop(int idx, uint64_t seen) {
+    while (true) {
+        const std::function<void(int)> *job;
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            wake_.wait(lk, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            job = job_;
+        }
+
+        (*job)(idx);
+
+        std::lock_guard<std::mutex> lg(m_);
+        if (--pending_ == 0) {
+            idle_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::stop_workers() {
+    {
+        std::lock_guard<std::mutex> lg(m_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &th: workers_) {
+        th.join();
+    }
+    workers_.clear();
+    stop_ = false;
+}
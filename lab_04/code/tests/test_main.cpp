@@ -1,14 +1,39 @@
+#include "ContractionHierarchy.h"
+#include "CsrGraph.h"
+#include "DijkstraAlt.h"
+#include "DijkstraBatch.h"
+#include "DijkstraBidir.h"
+#include "DijkstraBucket.h"
+#include "DijkstraCh.h"
+#include "DijkstraDense.h"
+#include "DijkstraDelta.h"
+#include "DijkstraHeap.h"
+#include "DijkstraHub.h"
 #include "DijkstraPar.h"
 #include "DijkstraSeq.h"
 #include "Graph.h"
+#include "GraphPartition.h"
+#include "GraphSnapshot.h"
+#include "HubLabels.h"
+#include "Landmarks.h"
+#include "NearestTargets.h"
+#include "PathRecovery.h"
+#include "PerfCounter.h"
+#include "VertexOrder.h"
+#include "WorkerPool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
+#include <memory>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -63,6 +88,13 @@ static uint64_t sum_path_weight(const Graph &g, const std::vector<int> &path) {
     return sum;
 }
 
+static bool same_names(const Graph &a, const Graph &b) {
+    if (a.size() != b.size()) return false;
+    for (int v = 0; v < (int) a.size(); ++v)
+        if (a.name(v) != b.name(v)) return false;
+    return true;
+}
+
 static void test_linear_graph() {
     std::string dot = R"(digraph G {
 A -> B [label=1];
@@ -110,6 +142,123 @@ E; // isolated
     CHECK(r.dist[D] == 8);
 }
 
+static void test_dot_parser_subset() {
+    std::string dot = R"(strict digraph "G" {
+  graph [rankdir=LR];
+  node [shape=circle];
+  rankdir=LR;
+  /* блочный
+     комментарий -> */
+  "X" -> Y -> "Z" [color=red, weight=7];
+  Y -> X [label="3"];
+  "W";
+  X -> W
+}
+)";
+    auto path = write_temp(dot);
+    Graph g = Graph::load_from_dot(path);
+
+    CHECK(g.size() == 4);
+    CHECK(!g.find_node("G"));
+    CHECK(!g.find_node("rankdir"));
+    // Объявленная вершина получает индекс раньше вершин из дуг
+    CHECK(*g.find_node("W") == 0);
+    CHECK(*g.find_node("X") == 1);
+
+    int X = *g.find_node("X");
+    int Y = *g.find_node("Y");
+    int Z = *g.find_node("Z");
+    int W = *g.find_node("W");
+
+    DijkstraSequential seq(g, X);
+    auto r = seq.run();
+    CHECK(r.dist[Y] == 7);
+    CHECK(r.dist[Z] == 14);
+    CHECK(r.dist[W] == 1);
+
+    DijkstraSequential back(g, Y);
+    CHECK(back.run().dist[X] == 3);
+}
+
+static void test_dot_parser_errors() {
+    bool thrown = false;
+    try {
+        Graph::load_from_dot(write_temp("digraph G {\n A -> B [label=4294967296];\n}\n"));
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try {
+        Graph::load_from_dot(write_temp("graph G {\n A -- B;\n}\n"));
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    Graph g = Graph::load_from_dot(write_temp("digraph G {\n A -> B [label=4294967295];\n}\n"));
+    CHECK(g.adj[*g.find_node("A")][0].second == UINT32_MAX);
+}
+
+static void test_name_table() {
+    NameTable t;
+    CHECK(!t.find("a"));
+    for (int i = 0; i < 5000; ++i) {
+        std::string name = "v";
+        name += std::to_string(i);
+        CHECK(t.intern(name) == i);
+    }
+    CHECK(t.size() == 5000);
+    CHECK(t.intern("v123") == 123);
+    CHECK(t.find("v4999") == std::optional<int>(4999));
+    CHECK(!t.find("v5000"));
+    CHECK(t.name(42) == "v42");
+
+    std::string long_name(100, 'x');
+    int idx = t.intern(long_name);
+    CHECK(t.find(std::string_view(long_name)) == std::optional<int>(idx));
+    CHECK(t.intern("") == idx + 1);
+    CHECK(t.find("") == std::optional<int>(idx + 1));
+}
+
+static void test_name_table_numeric_modes() {
+    NameTable dense;
+    for (int i = 0; i < 100; ++i) {
+        CHECK(dense.intern(std::to_string(i)) == i);
+    }
+    CHECK(dense.intern("17") == 17);
+    CHECK(dense.mode() == NameTable::Mode::Dense);
+    CHECK(dense.bytes() == 0);
+    CHECK(dense.find("99") == std::optional<int>(99));
+    CHECK(!dense.find("100"));
+    CHECK(!dense.find("017"));
+    CHECK(dense.name(42) == "42");
+
+    // Номера не по порядку: массивы число<->индекс
+    NameTable shuffled;
+    CHECK(shuffled.intern("5") == 0);
+    CHECK(shuffled.intern("0") == 1);
+    CHECK(shuffled.intern("5") == 0);
+    CHECK(shuffled.mode() == NameTable::Mode::Numeric);
+    CHECK(shuffled.find("0") == std::optional<int>(1));
+    CHECK(!shuffled.find("1"));
+    CHECK(shuffled.name(0) == "5");
+
+    // Нечисловое имя переводит таблицу в строковый режим без потери индексов
+    CHECK(shuffled.intern("A") == 2);
+    CHECK(shuffled.mode() == NameTable::Mode::Strings);
+    CHECK(shuffled.find("5") == std::optional<int>(0));
+    CHECK(shuffled.find("0") == std::optional<int>(1));
+    CHECK(shuffled.name(1) == "0");
+    CHECK(shuffled.intern("007") == 3);
+
+    Graph g = Graph::load_from_dot(write_temp("digraph G {\n \"0\";\n \"1\";\n \"2\";\n \"0\" -> \"2\" [label=4];\n}\n"));
+    CHECK(g.names.mode() == NameTable::Mode::Dense);
+    CHECK(g.find_node("2") == std::optional<int>(2));
+    CHECK(g.name(2) == "2");
+}
+
 static Graph make_random_graph(int n, int max_out, int max_w, uint32_t seed) {
     Graph g;
     for (int i = 0; i < n; ++i) {
@@ -130,6 +279,113 @@ static Graph make_random_graph(int n, int max_out, int max_w, uint32_t seed) {
     return g;
 }
 
+static void test_parallel_loader_matches_sequential() {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> vd(0, 2999);
+    std::uniform_int_distribution<int> wd(1, 100);
+    std::string dot = "digraph G {\n";
+    for (int i = 0; i < 1000; ++i) {
+        dot += "  \"" + std::to_string(i) + "\";\n";
+    }
+    for (int i = 0; i < 60000; ++i) {
+        dot += "  \"" + std::to_string(vd(rng)) + "\" -> \"" + std::to_string(vd(rng)) + "\" [label=" + std::to_string(wd(rng)) + "];\n";
+        if (i % 7000 == 0) {
+            dot += "  \"late_" + std::to_string(i) + "\";\n";
+        }
+    }
+    dot += "}\n";
+    CHECK(dot.size() >= Config::PARALLEL_LOAD_MIN_BYTES);
+    auto path = write_temp(dot);
+
+    Graph seq = Graph::load_from_dot(path);
+    for (int threads: {2, 3, 8}) {
+        Graph par = Graph::load_from_dot_parallel(path, threads);
+        CHECK(par.size() == seq.size());
+        CHECK(same_names(par, seq));
+        CHECK(par.adj == seq.adj);
+    }
+}
+
+static void test_binary_snapshot_roundtrip() {
+    Graph g = make_random_graph(250, 6, 40, 11);
+    g.ensure_node("имя с пробелом");
+    g.add_edge(0, static_cast<int>(g.size()) - 1, 3);
+
+    auto path = write_temp("");
+    g.save_binary(path);
+    CHECK(GraphSnapshot::is_snapshot(path));
+
+    GraphSnapshot snap = GraphSnapshot::open(path);
+    CHECK(snap.size() == g.size());
+    CHECK(snap.csr().edge_count() == CsrGraph(g).edge_count());
+    CHECK(snap.csr().max_weight() == CsrGraph(g).max_weight());
+    for (int v = 0; v < (int) g.size(); ++v) {
+        CHECK(snap.name(v) == g.name(v));
+        CHECK(snap.find_node(g.name(v)) == std::optional<int>(v));
+    }
+    CHECK(!snap.find_node("нет такой"));
+
+    DijkstraSequential a(g, 0);
+    DijkstraSequential b(snap.csr(), 0);
+    CHECK(a.run().dist == b.run().dist);
+
+    Graph back = Graph::load_binary(path);
+    CHECK(back.adj == g.adj);
+    CHECK(same_names(back, g));
+
+    // Снимок версии 1 без max_weight: вес восстанавливается сканированием дуг
+    {
+        SnapshotHeader h;
+        int fd = open(path.c_str(), O_RDWR);
+        CHECK(pread(fd, &h, sizeof(h), 0) == (ssize_t) sizeof(h));
+        h.version = 1;
+        h.max_weight = 0;
+        CHECK(pwrite(fd, &h, sizeof(h), 0) == (ssize_t) sizeof(h));
+        close(fd);
+        CHECK(GraphSnapshot::open(path).csr().max_weight() == CsrGraph(g).max_weight());
+    }
+
+    // Структурная порча ловится и без контрольной суммы: немонотонные
+    // смещения, номер дуги или порядка имён вне [0, n)
+    const size_t n = g.size(), m = CsrGraph(g).edge_count();
+    const size_t to_at = sizeof(SnapshotHeader) + (n + 1) * sizeof(uint64_t);
+    const size_t noff_at = to_at + (m * sizeof(int) + 7) / 8 * 8 + (m * sizeof(uint32_t) + 7) / 8 * 8;
+    const size_t order_at = noff_at + (n + 1) * sizeof(uint64_t);
+    auto corrupt = [&](size_t at, const void *data, size_t len) {
+        g.save_binary(path);
+        int fd = open(path.c_str(), O_WRONLY);
+        CHECK(pwrite(fd, data, len, at) == (ssize_t) len);
+        close(fd);
+    };
+    auto rejects = [&](bool verify) {
+        try {
+            GraphSnapshot::open(path, verify);
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+    const uint64_t big_offset = m;
+    const int bad_ids[] = {static_cast<int>(n), -1};
+    corrupt(sizeof(SnapshotHeader) + sizeof(uint64_t), &big_offset, sizeof(big_offset));
+    CHECK(rejects(false));
+    corrupt(noff_at + sizeof(uint64_t), &big_offset, sizeof(big_offset));
+    CHECK(rejects(false));
+    for (int id: bad_ids) {
+        corrupt(to_at + 5 * sizeof(int), &id, sizeof(id));
+        CHECK(rejects(false));
+        corrupt(order_at + 3 * sizeof(int), &id, sizeof(id));
+        CHECK(rejects(false));
+    }
+
+    // Порча данных обнаруживается контрольной суммой (только с verify):
+    // вес дуги структуру не нарушает
+    const uint32_t other_weight = 12345;
+    corrupt(to_at + (m * sizeof(int) + 7) / 8 * 8, &other_weight, sizeof(other_weight));
+    CHECK(!rejects(false));
+    CHECK(rejects(true));
+}
+
 static void test_parallel_equals_sequential() {
     Graph g = make_random_graph(300, 5, 20, 42);
     int start = 0;
@@ -149,6 +405,1027 @@ static void test_parallel_equals_sequential() {
     }
 }
 
+static void test_csr_matches_adjacency() {
+    Graph g = make_random_graph(200, 6, 50, 7);
+    CsrGraph csr(g);
+
+    CHECK(csr.size() == g.size());
+    size_t m = 0;
+    bool same = true;
+    for (int u = 0; u < (int) g.size(); ++u) {
+        m += g.adj[u].size();
+        if (csr.out_degree(u) != g.adj[u].size()) {
+            same = false;
+            continue;
+        }
+        uint64_t e = csr.offsets()[u];
+        for (auto [v, w]: g.adj[u]) {
+            if (csr.targets()[e] != v || csr.weights()[e] != w) same = false;
+            ++e;
+        }
+    }
+    CHECK(same);
+    CHECK(csr.edge_count() == m);
+
+    DijkstraSequential from_graph(g, 0);
+    DijkstraSequential from_csr(csr, 0);
+    auto a = from_graph.run();
+    auto b = from_csr.run();
+    CHECK(a.dist == b.dist);
+
+    DijkstraParallel par(csr, 0, 2);
+    CHECK(par.run().dist == a.dist);
+}
+
+static void test_heap_engine_matches_linear() {
+    for (int max_out: {3, 40}) {
+        Graph g = make_random_graph(400, max_out, 30, 100 + max_out);
+        // Дуги нулевого веса и петля не должны ломать порядок извлечения
+        g.add_edge(0, 1, 0);
+        g.add_edge(1, 1, 0);
+        CsrGraph csr(g);
+        auto rs = DijkstraSequential(csr, 0).run();
+
+        for (int arity: {2, 4, 8}) {
+            auto rh = DijkstraHeap(csr, 0, arity).run();
+            CHECK(rh.dist == rs.dist);
+            // Каждая вершина дерева достижима по дуге из родителя с точным весом
+            bool parents_ok = true;
+            for (int v = 1; v < (int) g.size(); ++v) {
+                if (rh.dist[v] >= Config::INF) continue;
+                int p = rh.parent[v];
+                bool found = false;
+                for (auto [to, w]: g.adj[p])
+                    if (to == v && rh.dist[p] + w == rh.dist[v]) found = true;
+                if (!found) parents_ok = false;
+            }
+            CHECK(parents_ok);
+        }
+    }
+
+    Graph g = make_random_graph(10, 2, 5, 1);
+    bool thrown = false;
+    try {
+        DijkstraHeap(g, 0, 3).run();
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+static void test_bucket_engine_matches_linear() {
+    using Strategy = DijkstraBucket::Strategy;
+    for (int max_w: {1, 30, 100000}) {
+        Graph g = make_random_graph(400, 6, max_w, 200 + max_w);
+        g.add_edge(0, 1, 0);
+        g.add_edge(2, 2, 0);
+        CsrGraph csr(g);
+        CHECK(csr.max_weight() <= static_cast<uint32_t>(max_w));
+        auto rs = DijkstraSequential(csr, 0).run();
+
+        DijkstraBucket automatic(csr, 0);
+        CHECK(automatic.strategy() == (max_w <= (int) Config::DIAL_MAX_WEIGHT ? Strategy::Dial : Strategy::Radix));
+        CHECK(automatic.run().dist == rs.dist);
+        CHECK(DijkstraBucket(csr, 0, Strategy::Dial).run().dist == rs.dist);
+        CHECK(DijkstraBucket(csr, 0, Strategy::Radix).run().dist == rs.dist);
+    }
+
+    // Граф без дуг и веса у границы uint32_t
+    Graph g;
+    g.ensure_node("a");
+    g.ensure_node("b");
+    g.ensure_node("c");
+    CHECK(DijkstraBucket(g, 0).run().dist[1] == Config::INF);
+    g.add_edge(0, 1, UINT32_MAX);
+    g.add_edge(1, 2, UINT32_MAX);
+    auto r = DijkstraBucket(g, 0).run();
+    CHECK(r.dist[2] == 2ULL * UINT32_MAX);
+    CHECK(r.parent[2] == 1);
+}
+
+// Путь по parent от цели до старта проходит по дугам с точными весами
+static bool parent_chain_ok(const Graph &g, const std::vector<uint64_t> &dist, const std::vector<int> &parent, int start, int target) {
+    for (int v = target; v != start; v = parent[v]) {
+        int p = parent[v];
+        if (p < 0) return false;
+        bool found = false;
+        for (auto [to, w]: g.adj[p])
+            if (to == v && dist[p] + w == dist[v]) found = true;
+        if (!found) return false;
+    }
+    return true;
+}
+
+static void test_early_stop_on_targets() {
+    Graph g = make_random_graph(2000, 6, 50, 314);
+    CsrGraph csr(g);
+    auto full = DijkstraSequential(csr, 0).run();
+    CHECK(full.settled <= g.size());
+
+    std::vector<int> targets = {5, 17, 1999, 5};
+    auto expect_targets = [&](const std::vector<uint64_t> &dist, const std::vector<int> &parent) {
+        bool ok = true;
+        for (int t: targets) {
+            if (dist[t] != full.dist[t]) ok = false;
+            if (dist[t] < Config::INF && !parent_chain_ok(g, dist, parent, 0, t)) ok = false;
+        }
+        return ok;
+    };
+
+    DijkstraSequential seq(csr, 0);
+    seq.set_targets(targets);
+    auto rs = seq.run();
+    CHECK(expect_targets(rs.dist, rs.parent));
+    CHECK(rs.settled < full.settled);
+
+    DijkstraHeap heap(csr, 0);
+    heap.set_targets(targets);
+    auto rh = heap.run();
+    CHECK(expect_targets(rh.dist, rh.parent));
+    CHECK(rh.settled < full.settled);
+
+    for (auto strategy: {DijkstraBucket::Strategy::Dial, DijkstraBucket::Strategy::Radix}) {
+        DijkstraBucket bucket(csr, 0, strategy);
+        bucket.set_targets(targets);
+        auto rb = bucket.run();
+        CHECK(expect_targets(rb.dist, rb.parent));
+        CHECK(rb.settled < full.settled);
+    }
+
+    for (int th: {1, 2, 4}) {
+        DijkstraParallel par(csr, 0, th);
+        par.set_targets(targets);
+        auto rp = par.run();
+        CHECK(expect_targets(rp.dist, rp.parent));
+    }
+
+    // Недостижимая цель: поиск обходит всё достижимое и завершается
+    g.ensure_node("island");
+    CsrGraph with_island(g);
+    int island = static_cast<int>(g.size()) - 1;
+    DijkstraSequential seq2(with_island, 0);
+    seq2.set_targets({5, island});
+    auto r2 = seq2.run();
+    CHECK(r2.dist[island] == Config::INF);
+    CHECK(r2.settled == full.settled);
+    DijkstraParallel par2(with_island, 0, 2);
+    par2.set_targets({5, island});
+    auto p2 = par2.run();
+    CHECK(p2.dist[island] == Config::INF);
+    CHECK(p2.dist[5] == full.dist[5]);
+}
+
+static void test_bidirectional_matches_full() {
+    Graph g = make_random_graph(3000, 4, 50, 2718);
+    g.ensure_node("island");
+    g.add_edge(7, 8, 0);
+    CsrGraph csr(g);
+    const int island = static_cast<int>(g.size()) - 1;
+
+    CsrGraph rev = csr.reversed();
+    CHECK(rev.size() == csr.size());
+    CHECK(rev.edge_count() == csr.edge_count());
+    CHECK(rev.max_weight() == csr.max_weight());
+    CHECK(DijkstraSequential(rev, 0).run().dist != DijkstraSequential(csr, 0).run().dist);
+
+    auto full = DijkstraHeap(csr, 0).run();
+
+    std::vector<int> targets = {5, 8, 2999, island, 0, 1234};
+    DijkstraBidirectional bidir(csr, 0);
+    bidir.set_targets(targets);
+    auto r = bidir.run();
+    bool ok = true;
+    for (int t: targets) {
+        if (r.dist[t] != full.dist[t]) ok = false;
+        if (r.dist[t] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, 0, t)) ok = false;
+    }
+    CHECK(ok);
+    CHECK(r.dist[island] == Config::INF);
+    CHECK(r.parent[0] == -1);
+
+    // Один дальний таргет: двунаправленный поиск обходит заметно меньше вершин
+    int far = 0;
+    for (int v = 0; v < island; ++v)
+        if (full.dist[v] < Config::INF && full.dist[v] > full.dist[far]) far = v;
+    DijkstraBidirectional single(csr, 0);
+    single.set_targets({far});
+    auto rs = single.run();
+    CHECK(rs.dist[far] == full.dist[far]);
+    CHECK(rs.settled * 4 < full.settled);
+
+    // Без целей — полный однонаправленный поиск
+    CHECK(DijkstraBidirectional(g, 0).run().dist == full.dist);
+}
+
+static void test_alt_landmarks_and_query() {
+    Graph g = make_random_graph(3000, 4, 50, 1618);
+    g.ensure_node("island");
+    CsrGraph csr(g);
+    const int island = static_cast<int>(g.size()) - 1;
+
+    Landmarks lm = Landmarks::build(csr, 6);
+    CHECK(lm.count() == 6);
+
+    // Оценка не превышает истинного расстояния
+    auto full = DijkstraHeap(csr, 0).run();
+    bool admissible = true;
+    for (int t: {5, 100, 2999}) {
+        auto to_t = DijkstraHeap(csr.reversed(), t).run();
+        for (int v = 0; v < island; v += 7) {
+            uint64_t lb = lm.lower_bound(v, t);
+            if (to_t.dist[v] == Config::INF ? false : lb > to_t.dist[v]) admissible = false;
+        }
+    }
+    CHECK(admissible);
+    CHECK(lm.lower_bound(0, 0) == 0);
+
+    std::vector<int> targets = {5, 100, 2999, island, 0};
+    DijkstraAlt alt(csr, lm, 0);
+    alt.set_targets(targets);
+    auto r = alt.run();
+    bool ok = true;
+    for (int t: targets) {
+        if (r.dist[t] != full.dist[t]) ok = false;
+        if (r.dist[t] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, 0, t)) ok = false;
+    }
+    CHECK(ok);
+    CHECK(r.settled < full.settled);
+
+    // Сохранение и загрузка; файл другого графа отвергается
+    auto path = write_temp("");
+    lm.save(path);
+    Landmarks back = Landmarks::load(path, csr);
+    CHECK(back.ids() == lm.ids());
+    bool same_tables = true;
+    for (int v = 0; v < (int) g.size(); ++v)
+        for (int i = 0; i < (int) lm.count(); ++i)
+            if (back.from(i, v) != lm.from(i, v) || back.to(i, v) != lm.to(i, v)) same_tables = false;
+    CHECK(same_tables);
+
+    g.add_edge(1, 2, 3);
+    CsrGraph other(g);
+    bool thrown = false;
+    try {
+        Landmarks::load(path, other);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    unlink(path.c_str());
+}
+
+static void test_contraction_hierarchy() {
+    // Третий вариант — с маленьким порогом, чтобы запросы шли через ядро
+    for (auto [max_out, core_degree]: {std::pair<int, uint64_t>{3, Config::CH_CORE_DEGREE}, {12, Config::CH_CORE_DEGREE}, {12, 16}}) {
+        Graph g = make_random_graph(1500, max_out, 40, 900 + max_out);
+        g.ensure_node("island");
+        g.add_edge(3, 4, 0);
+        g.add_edge(5, 5, 1);
+        CsrGraph csr(g);
+        const int island = static_cast<int>(g.size()) - 1;
+
+        ContractionHierarchy ch = ContractionHierarchy::build(csr, core_degree);
+        CHECK(ch.size() == g.size());
+        std::vector<int> ranks;
+        for (int v = 0; v < (int) g.size(); ++v) ranks.push_back(ch.rank(v));
+        std::sort(ranks.begin(), ranks.end());
+        bool permutation = true;
+        for (int v = 0; v < (int) ranks.size(); ++v)
+            if (ranks[v] != v) permutation = false;
+        CHECK(permutation);
+
+        for (int start: {0, 4, 777}) {
+            auto full = DijkstraHeap(csr, start).run();
+            std::vector<int> targets = {1, 4, 1499, island, 250, start};
+            DijkstraCh query(ch, start);
+            query.set_targets(targets);
+            auto r = query.run();
+            bool ok = true;
+            for (int t: targets) {
+                if (r.dist[t] != full.dist[t]) ok = false;
+                if (r.dist[t] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, t)) ok = false;
+            }
+            CHECK(ok);
+        }
+
+        // Файл иерархии: те же ответы после загрузки, чужой граф отвергается
+        auto path = write_temp("");
+        ch.save(path);
+        ContractionHierarchy back = ContractionHierarchy::load(path, csr);
+        CHECK(back.shortcut_count() == ch.shortcut_count());
+        DijkstraCh q1(ch, 0), q2(back, 0);
+        q1.set_targets({1499, 250});
+        q2.set_targets({1499, 250});
+        CHECK(q1.run().dist == q2.run().dist);
+
+        g.add_edge(1, 2, 3);
+        CsrGraph other(g);
+        bool thrown = false;
+        try {
+            ContractionHierarchy::load(path, other);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        CHECK(thrown);
+        unlink(path.c_str());
+    }
+}
+
+static void test_hub_labels() {
+    for (int max_out: {3, 12}) {
+        Graph g = make_random_graph(1200, max_out, 30, 1300 + max_out);
+        // Цикл нулевого веса: восстановление пути не должно в нём застрять
+        g.add_edge(3, 4, 0);
+        g.add_edge(4, 3, 0);
+        g.add_edge(4, 9, 0);
+        g.ensure_node("island");
+        CsrGraph csr(g);
+        const int island = static_cast<int>(g.size()) - 1;
+
+        // Порядок по степени и порядок рангов CH дают одинаковые расстояния
+        std::vector<int> by_degree(g.size());
+        for (int v = 0; v < (int) g.size(); ++v) by_degree[v] = v;
+        std::sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return g.adj[a].size() > g.adj[b].size(); });
+        HubLabels labels = HubLabels::build(csr, by_degree);
+        HubLabels ch_labels = HubLabels::build(csr, ContractionHierarchy::build(csr).order());
+
+        bool same = true;
+        for (int start: {0, 3, 555}) {
+            auto full = DijkstraHeap(csr, start).run();
+            for (int v = 0; v < (int) g.size(); ++v) {
+                if (labels.distance(start, v) != full.dist[v] || ch_labels.distance(start, v) != full.dist[v]) same = false;
+            }
+
+            std::vector<int> targets = {9, 1199, island, 4, 600, start};
+            DijkstraHub query(labels, csr, start);
+            query.set_targets(targets);
+            auto r = query.run();
+            bool ok = true;
+            for (int t: targets) {
+                if (r.dist[t] != full.dist[t]) ok = false;
+                if (r.dist[t] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, t)) ok = false;
+            }
+            CHECK(ok);
+
+            DijkstraHub plain(labels, csr, start);
+            plain.set_targets(targets);
+            plain.set_recover_paths(false);
+            auto d = plain.run();
+            CHECK(d.dist[1199] == full.dist[1199] && d.parent[1199] == -1);
+        }
+        CHECK(same);
+
+        // Файл меток открывается через mmap; чужой граф отвергается
+        auto path = write_temp("");
+        labels.save(path);
+        HubLabels back = HubLabels::open(path, csr);
+        CHECK(back.entries() == labels.entries());
+        bool equal = true;
+        for (int t = 0; t < (int) g.size(); t += 7) {
+            if (back.distance(3, t) != labels.distance(3, t)) equal = false;
+        }
+        CHECK(equal);
+
+        g.add_edge(1, 2, 3);
+        CsrGraph other(g);
+        bool thrown = false;
+        try {
+            HubLabels::open(path, other);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        CHECK(thrown);
+        unlink(path.c_str());
+    }
+}
+
+static void test_query_workspace() {
+    Graph g = make_random_graph(900, 6, 50, 1414);
+    Graph small = make_random_graph(300, 4, 50, 1415);
+    CsrGraph csr(g), small_csr(small);
+
+    // Один workspace на серию запросов: результаты как у запросов с нуля,
+    // включая смену графа и досрочную остановку по целям
+    QueryWorkspace ws;
+    bool ok = true;
+    for (int start: {0, 17, 450, 899}) {
+        auto full = DijkstraHeap(csr, start).run();
+        DijkstraSequential seq(csr, start);
+        QueryView s = seq.run(ws);
+        if (s.dist_vector() != full.dist) ok = false;
+        for (int v = 0; v < (int) g.size(); ++v) {
+            if (s.dist(v) < Config::INF && !parent_chain_ok(g, s.dist_vector(), s.parent_vector(), start, v)) ok = false;
+        }
+
+        DijkstraParallel par(csr, start, 3);
+        QueryView p = par.run(ws);
+        if (p.dist_vector() != full.dist) ok = false;
+
+        std::vector<int> targets = {5, 800};
+        par.set_targets(targets);
+        QueryView pt = par.run(ws);
+        seq.set_targets(targets);
+        QueryView st = seq.run(ws);
+        for (int t: targets) {
+            if (st.dist(t) != full.dist[t] || pt.dist(t) != full.dist[t]) ok = false;
+        }
+        // Линейный поиск детерминирован: с целями извлекается префикс полного порядка
+        if (st.settled() > s.settled()) ok = false;
+
+        auto small_full = DijkstraHeap(small_csr, start % 300).run();
+        QueryView sm = DijkstraSequential(small_csr, start % 300).run(ws);
+        if (sm.size() != small.size() || sm.dist_vector() != small_full.dist) ok = false;
+    }
+    CHECK(ok);
+}
+
+static void test_delta_stepping() {
+    Graph g = make_random_graph(1500, 8, 200, 1516);
+    g.add_edge(2, 3, 0);
+    g.add_edge(3, 2, 0);
+    CsrGraph csr(g);
+
+    uint64_t auto_delta = DijkstraDelta::choose_delta(csr);
+    CHECK(auto_delta >= 1 && auto_delta <= csr.max_weight());
+
+    // Δ = 1 — почти Дейкстра, Δ больше всех весов — почти Беллман-Форд
+    QueryWorkspace ws;
+    bool ok = true;
+    for (int threads: {1, 3}) {
+        for (uint64_t delta: {uint64_t{0}, uint64_t{1}, uint64_t{37}, uint64_t{1000}}) {
+            for (int start: {0, 2, 1234}) {
+                auto full = DijkstraHeap(csr, start).run();
+                DijkstraDelta engine(csr, start, threads, delta);
+                auto r = engine.run();
+                if (r.dist != full.dist) ok = false;
+                for (int v = 0; v < (int) g.size(); v += 13) {
+                    if (r.dist[v] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+                }
+
+                std::vector<int> targets = {7, 800};
+                engine.set_targets(targets);
+                QueryView t = engine.run(ws);
+                for (int x: targets) {
+                    if (t.dist(x) != full.dist[x]) ok = false;
+                }
+                if (t.settled() > r.settled) ok = false;
+            }
+        }
+    }
+    CHECK(ok);
+
+    // Тяжёлый хвост: Δ ~ 1..10, отдельные дуги до 4e9 — корзины не должны
+    // расти с max_w / Δ, дальние записи идут через переполнение кольца
+    Graph heavy = make_random_graph(300, 16, 10, 1517);
+    heavy.add_edge(0, 299, 4000000000u);
+    heavy.add_edge(5, 150, 1000000);
+    heavy.add_edge(150, 151, 3000000000u);
+    for (int v = 10; v < 300; v += 37) {
+        heavy.add_edge(v, (v * 7) % 300, 50000 + v * 1000);
+    }
+    CsrGraph heavy_csr(heavy);
+    bool heavy_ok = DijkstraDelta::choose_delta(heavy_csr) <= 10;
+    for (int threads: {1, 3}) {
+        for (uint64_t delta: {uint64_t{0}, uint64_t{1}}) {
+            for (int start: {0, 5, 150}) {
+                auto full = DijkstraHeap(heavy_csr, start).run();
+                DijkstraDelta engine(heavy_csr, start, threads, delta);
+                auto r = engine.run();
+                if (r.dist != full.dist) heavy_ok = false;
+                for (int v = 0; v < (int) heavy.size(); ++v) {
+                    if (r.dist[v] < Config::INF && !parent_chain_ok(heavy, r.dist, r.parent, start, v)) heavy_ok = false;
+                }
+            }
+        }
+    }
+    CHECK(heavy_ok);
+}
+
+static void test_multiqueue() {
+    Graph g = make_random_graph(1200, 8, 100, 1616);
+    CsrGraph csr(g);
+
+    QueryWorkspace ws;
+    bool ok = true;
+    bool stats_ok = true;
+    for (int threads: {1, 3}) {
+        for (int c: {1, 2, 4}) {
+            for (int start: {0, 555}) {
+                auto full = DijkstraHeap(csr, start).run();
+                DijkstraParallel engine(csr, start, threads);
+                engine.set_queue_factor(c);
+                auto r = engine.run();
+                if (r.dist != full.dist) ok = false;
+                for (int v = 0; v < (int) g.size(); v += 11) {
+                    if (r.dist[v] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+                }
+
+                const SchedulerStats &st = engine.stats();
+                if (st.pops < r.settled || st.stale_pops > st.pops) stats_ok = false;
+                if (st.stale_ratio() < 0.0 || st.stale_ratio() > 1.0) stats_ok = false;
+                // На одной очереди каждая вершина извлекается ровно раз, ошибки ранга нет
+                if (threads == 1 && c == 1 && st.rank_error() != 0.0) stats_ok = false;
+                // Вставки уходят пачкой на вершину; один поток не засыпает и будит только при завершении
+                if (st.pushes != st.pops || st.settled != r.settled) stats_ok = false;
+                // Повторные раскрытия не считаются: полный поиск раскрывает каждую достижимую вершину ровно раз
+                uint64_t reachable = std::count_if(full.dist.begin(), full.dist.end(),
+                                                   [](uint64_t d) { return d < Config::INF; });
+                if (r.settled != reachable || st.settled + st.reexpansions + st.stale_pops != st.pops) stats_ok = false;
+                if (threads == 1 && (st.locks > st.pops + st.settled + 1 || st.notifications != 1)) stats_ok = false;
+
+                engine.set_targets({42});
+                QueryView t = engine.run(ws);
+                if (t.dist(42) != full.dist[42]) ok = false;
+            }
+        }
+    }
+    CHECK(ok);
+    CHECK(stats_ok);
+
+    // Буфер из одной вставки — сброс на каждой релаксации
+    bool small_batch = true;
+    for (int threads: {1, 4}) {
+        auto full = DijkstraHeap(csr, 9).run();
+        DijkstraParallel engine(csr, 9, threads);
+        engine.set_push_batch(1);
+        if (engine.run().dist != full.dist) small_batch = false;
+    }
+    CHECK(small_batch);
+
+    int thrown = 0;
+    try {
+        DijkstraParallel(csr, 0, 2).set_queue_factor(0);
+    } catch (const std::invalid_argument &) {
+        ++thrown;
+    }
+    try {
+        DijkstraParallel(csr, 0, 2).set_push_batch(0);
+    } catch (const std::invalid_argument &) {
+        ++thrown;
+    }
+    CHECK(thrown == 2);
+}
+
+static void test_worker_pool() {
+    WorkerPool pool(3);
+    CHECK(pool.size() == 3);
+
+    // Каждый индекс выполняется ровно раз за run, в том числе после resize
+    bool ok = true;
+    for (int size: {3, 1, 4, 4, 2}) {
+        pool.resize(size);
+        std::vector<std::atomic<int>> hits(size);
+        for (int round = 0; round < 50; ++round) {
+            pool.run([&](int idx) { hits[idx].fetch_add(1); });
+        }
+        for (auto &h: hits) {
+            if (h.load() != 50) ok = false;
+        }
+    }
+    CHECK(ok);
+
+    bool thrown = false;
+    try {
+        pool.run([](int idx) {
+            if (idx == 0) throw std::runtime_error("job");
+        });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // Движки на каждый запрос делят пул, set_threads меняет его размер
+    Graph g = make_random_graph(600, 6, 50, 1717);
+    CsrGraph csr(g);
+    auto shared = std::make_shared<WorkerPool>(2);
+    QueryWorkspace ws;
+    bool same = true;
+    for (int start: {0, 17, 333}) {
+        auto full = DijkstraHeap(csr, start).run();
+        DijkstraParallel engine(csr, start, 2);
+        engine.set_pool(shared);
+        if (engine.run(ws).dist_vector() != full.dist) same = false;
+        engine.set_threads(3);
+        if (shared->size() != 3) same = false;
+        if (engine.run(ws).dist_vector() != full.dist) same = false;
+        engine.set_threads(2);
+    }
+    CHECK(same);
+}
+
+static void test_packed_distances() {
+    // Упаковка выбирается по границе (n - 1) * max_w
+    QueryWorkspace ws;
+    ws.begin_packed(100, (uint64_t{1} << 32) - 2);
+    CHECK(ws.parent_bits() == 32);
+    ws.begin_packed(100, uint64_t{1} << 32);
+    CHECK(ws.parent_bits() == 24);
+    ws.begin_packed(100, uint64_t{1} << 40);
+    CHECK(!ws.packed());
+    ws.begin_packed(size_t{1} << 24, uint64_t{1} << 32);
+    CHECK(!ws.packed());
+
+    ws.begin_packed(10, 1000);
+    ws.reset(0, 10);
+    CHECK(!ws.reached(3) && ws.dist(3) >= Config::INF && ws.parent(3) == -1);
+    CHECK(ws.try_relax(3, 50, 7));
+    CHECK(!ws.try_relax(3, 60, 8));
+    CHECK(ws.try_relax(3, 20, 9));
+    CHECK(ws.dist(3) == 20 && ws.parent(3) == 9 && ws.load_dist(3) == 20);
+
+    bool ok = true;
+    for (auto [max_w, bits]: {std::pair{100, 32}, std::pair{1 << 22, 24}, std::pair{1 << 30, 0}}) {
+        Graph g = make_random_graph(1200, 6, max_w, 1919);
+        CsrGraph csr(g);
+        for (int threads: {1, 3}) {
+            for (int start: {0, 404}) {
+                auto full = DijkstraHeap(csr, start).run();
+                DijkstraParallel engine(csr, start, threads);
+                QueryView view = engine.run(ws);
+                if ((ws.packed() ? ws.parent_bits() : 0) != bits) ok = false;
+                if (view.dist_vector() != full.dist) ok = false;
+                auto r = engine.run();
+                if (r.dist != full.dist) ok = false;
+                for (int v = 0; v < (int) g.size(); v += 7) {
+                    if (r.dist[v] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+                }
+            }
+        }
+        // После упакованного запроса тот же workspace служит последовательному движку
+        QueryView seq = DijkstraSequential(csr, 5).run(ws);
+        if (ws.packed() || seq.dist_vector() != DijkstraHeap(csr, 5).run().dist) ok = false;
+    }
+    CHECK(ok);
+}
+
+static void test_distances_only() {
+    Graph g = make_random_graph(900, 6, 30, 2020);
+    // Цикл нулевого веса: первый подходящий предок может завести в цикл
+    g.add_edge(2, 3, 0);
+    g.add_edge(3, 4, 0);
+    g.add_edge(4, 2, 0);
+    CsrGraph csr(g);
+    CsrGraph reverse = csr.reversed();
+
+    auto full = DijkstraHeap(csr, 0).run();
+    std::vector<int> none(g.size(), -1);
+    QueryWorkspace ws;
+    bool ok = true;
+
+    DijkstraSequential seq(csr, 0);
+    seq.set_record_parents(false);
+    auto rs = seq.run();
+    if (rs.dist != full.dist || rs.parent != none) ok = false;
+    seq.run(ws);
+    if (ws.parents() || ws.parent(5) != -1) ok = false;
+
+    for (int threads: {1, 3}) {
+        DijkstraParallel par(csr, 0, threads);
+        par.set_record_parents(false);
+        auto rp = par.run();
+        if (rp.dist != full.dist || rp.parent != none) ok = false;
+        par.set_targets({4, 321});
+        QueryView view = par.run(ws);
+        if (!ws.packed() || ws.parent_bits() != 0) ok = false;
+        if (view.dist(4) != full.dist[4] || view.dist(321) != full.dist[321]) ok = false;
+    }
+    CHECK(ok);
+
+    // Путь по входящим дугам согласован с расстояниями
+    bool paths_ok = true;
+    for (int t: {2, 3, 4, 77, 500, 899}) {
+        std::vector<int> path = recover_path(reverse, 0, t, [&](int v) { return full.dist[v]; });
+        if (full.dist[t] >= Config::INF) {
+            if (!path.empty()) paths_ok = false;
+            continue;
+        }
+        if (path.empty() || path.front() != 0 || path.back() != t) {
+            paths_ok = false;
+            continue;
+        }
+        std::vector<int> parent(g.size(), -1);
+        for (size_t j = 1; j < path.size(); ++j) {
+            parent[path[j]] = path[j - 1];
+        }
+        if (!parent_chain_ok(g, full.dist, parent, 0, t)) paths_ok = false;
+    }
+    CHECK(paths_ok);
+
+    bool thrown = false;
+    try {
+        recover_path(reverse, 0, 77, [&](int v) { return v == 77 ? full.dist[v] + 1000 : full.dist[v]; });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+static void test_batch_sources() {
+    Graph g = make_random_graph(700, 6, 40, 2121);
+    g.add_edge(2, 3, 0);
+    g.add_edge(3, 4, 0);
+    g.add_edge(4, 2, 0);
+    CsrGraph csr(g);
+
+    // Две группы, неполная вторая, повторяющийся исток
+    std::vector<int> sources = {0, 2, 3, 699, 5, 5, 100, 250, 333, 2, 611};
+    auto results = DijkstraBatch(csr, sources).run();
+    CHECK(results.size() == sources.size());
+
+    bool ok = true;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        auto full = DijkstraHeap(csr, sources[i]).run();
+        if (results[i].dist != full.dist || results[i].settled != full.settled) ok = false;
+        for (int v = 0; v < (int) g.size(); v += 9) {
+            if (full.dist[v] < Config::INF && !parent_chain_ok(g, results[i].dist, results[i].parent, sources[i], v)) ok = false;
+        }
+    }
+    CHECK(ok);
+
+    DijkstraBatch dist_only(csr, {7, 8});
+    dist_only.set_record_parents(false);
+    auto r = dist_only.run();
+    CHECK(r[1].dist == DijkstraHeap(csr, 8).run().dist);
+    CHECK(r[1].parent == std::vector<int>(g.size(), -1));
+
+    CHECK(DijkstraBatch(csr, {}).run().empty());
+    bool thrown = false;
+    try {
+        DijkstraBatch(csr, {0, 700}).run();
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+static void test_dense_engine() {
+    // 601 вершина — строка матрицы с дополнением; кратные дуги, нулевой цикл, изолированная вершина
+    Graph g = make_random_graph(600, 40, 30, 5150);
+    g.add_edge(0, 9, 1000);
+    g.add_edge(0, 9, 1);
+    g.add_edge(20, 21, 0);
+    g.add_edge(21, 20, 0);
+    g.ensure_node("island");
+    CsrGraph csr(g);
+    DenseGraph dense(csr);
+    CHECK(dense.size() == g.size() && dense.stride() % 8 == 0 && dense.stride() >= g.size());
+    CHECK(dense.row(0)[9] == 1);
+
+    bool ok = true;
+    for (int start: {0, 20, 599}) {
+        auto expect = DijkstraSequential(csr, start).run();
+        auto r = DijkstraDense(dense, start).run();
+        if (r.dist != expect.dist || r.settled != expect.settled) ok = false;
+        for (int v = 0; v < (int) g.size(); v += 7) {
+            if (r.dist[v] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+        }
+    }
+    CHECK(ok);
+
+    // Остановка на целях — после тех же извлечений, что у линейного движка
+    std::vector<int> targets = {5, 77, 300};
+    DijkstraSequential seq(csr, 0);
+    seq.set_targets(targets);
+    auto expect = seq.run();
+    DijkstraDense early(dense, 0);
+    early.set_targets(targets);
+    early.set_record_parents(false);
+    auto r = early.run();
+    CHECK(r.settled == expect.settled);
+    CHECK(r.dist[5] == expect.dist[5] && r.dist[77] == expect.dist[77] && r.dist[300] == expect.dist[300]);
+    CHECK(r.parent == std::vector<int>(g.size(), -1));
+    CHECK(r.dist[g.size() - 1] == Config::INF);
+
+    bool thrown = false;
+    try {
+        Graph big;
+        for (size_t i = 0; i <= Config::DENSE_MAX_VERTICES; ++i) big.ensure_node(std::to_string(i));
+        DenseGraph{CsrGraph(big)};
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try {
+        g.add_edge(1, 2, DenseGraph::MISSING);
+        DenseGraph{CsrGraph(g)};
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+// Решётка side x side с перемешанными номерами; id[клетка] — номер вершины.
+// Дуги вправо и вверх, веса зависят от клетки
+static Graph make_shuffled_grid(int side, uint32_t seed, std::vector<int> &id) {
+    std::vector<int> cells(side * side);
+    for (int i = 0; i < (int) cells.size(); ++i) cells[i] = i;
+    std::mt19937 rng(seed);
+    std::shuffle(cells.begin(), cells.end(), rng);
+    Graph g;
+    id.assign(cells.size(), -1);
+    for (int c: cells) id[c] = g.ensure_node(std::to_string(c));
+    for (int c = 0; c < side * side; ++c) {
+        if (c % side + 1 < side) g.add_edge(id[c], id[c + 1], 1 + c % 7);
+        if (c + side < side * side) g.add_edge(id[c + side], id[c], 1 + c % 5);
+    }
+    return g;
+}
+
+static void test_vertex_order() {
+    // Решётка 30 x 30 с перемешанными номерами и отдельная компонента из двух вершин
+    std::vector<int> id;
+    Graph g = make_shuffled_grid(30, 77, id);
+    int a = g.ensure_node("a"), b = g.ensure_node("b");
+    g.add_edge(a, b, 3);
+    CsrGraph csr(g);
+
+    // Ширина ленты: наибольшая разность номеров концов дуги
+    auto bandwidth = [](const CsrGraph &c) {
+        int bw = 0;
+        for (int u = 0; u < (int) c.size(); ++u)
+            for (uint64_t e = c.offsets()[u]; e < c.offsets()[u + 1]; ++e) bw = std::max(bw, std::abs(c.targets()[e] - u));
+        return bw;
+    };
+
+    const int start = id[0];
+    auto expect = DijkstraHeap(csr, start).run();
+    for (const char *name: {"bfs", "rcm", "degree"}) {
+        VertexOrder order = VertexOrder::compute(csr, VertexOrder::parse(name));
+        std::vector<int> sorted = order.order();
+        std::sort(sorted.begin(), sorted.end());
+        bool perm = (int) sorted.size() == (int) g.size();
+        for (int i = 0; i < (int) sorted.size(); ++i) perm = perm && sorted[i] == i && order.to_old(order.to_new(i)) == i;
+        CHECK(perm);
+
+        CsrGraph re = csr.permuted(order.order());
+        CHECK(re.size() == csr.size() && re.edge_count() == csr.edge_count() && re.max_weight() == csr.max_weight());
+        if (std::string(name) != "degree") CHECK(bandwidth(re) < bandwidth(csr) / 4);
+
+        // Результат в новых номерах, переведённый обратно, совпадает с исходным
+        auto r = DijkstraHeap(re, order.to_new(start)).run();
+        order.restore(r.dist, r.parent);
+        bool ok = r.dist == expect.dist;
+        for (int v = 0; v < (int) g.size(); v += 11)
+            if (r.dist[v] < Config::INF && !parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+        CHECK(ok);
+
+        std::vector<uint64_t> dist(g.size(), 0);
+        std::vector<int> no_parent;
+        order.restore(dist, no_parent);
+        CHECK(no_parent.empty() && dist.size() == g.size());
+    }
+    CHECK(VertexOrder::compute(csr, VertexOrder::Strategy::Degree).to_old(0) != a);
+
+    bool thrown = false;
+    try {
+        VertexOrder::parse("random");
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // Счётчик промахов может быть недоступен (виртуальная машина), но не врёт
+    PerfCounter counter;
+    counter.start();
+    DijkstraHeap(csr, start).run();
+    long long misses = counter.stop();
+    CHECK(counter.available() ? misses >= 0 : misses == -1);
+}
+
+static void test_graph_partition() {
+    std::vector<int> id;
+    Graph g = make_shuffled_grid(48, 99, id);
+    // Обратные дуги, чтобы из угла достигалась вся решётка
+    for (int c = 0; c + 1 < 48 * 48; ++c) {
+        if (c % 48 + 1 < 48) g.add_edge(id[c + 1], id[c], 2);
+        if (c + 48 < 48 * 48) g.add_edge(id[c], id[c + 48], 3);
+    }
+    CsrGraph csr(g);
+    const int start = id[0];
+    auto full = DijkstraHeap(csr, start).run();
+
+    bool ok = true;
+    for (int threads: {1, 3, 4}) {
+        auto partition = std::make_shared<GraphPartition>(GraphPartition::build(csr, threads));
+        std::vector<size_t> sizes(threads, 0);
+        for (int v = 0; v < (int) g.size(); ++v) ++sizes[partition->part(v)];
+        const size_t cap = static_cast<size_t>(std::ceil(g.size() / (double) threads * (1 + Config::PARTITION_IMBALANCE)));
+        for (size_t s: sizes) if (s > cap || s == 0) ok = false;
+        if (threads == 1 && partition->cut_edges() != 0) ok = false;
+        // У решётки граница частей — O(side) дуг из O(side^2)
+        if (threads > 1 && partition->cut_fraction() > 0.1) ok = false;
+
+        DijkstraParallel random_owners(csr, start, threads);
+        auto r0 = random_owners.run();
+        DijkstraParallel owned(csr, start, threads);
+        owned.set_partition(partition);
+        auto r = owned.run();
+        if (r.dist != full.dist || r0.dist != full.dist) ok = false;
+        for (int v = 0; v < (int) g.size(); v += 13) {
+            if (!parent_chain_ok(g, r.dist, r.parent, start, v)) ok = false;
+        }
+        // Доля чужих вставок зависит от планировщика ОС (сравнение — в lab04 -o);
+        // один поток владеет всеми очередями
+        const SchedulerStats &st = owned.stats();
+        if (st.cross_pushes > st.pushes || st.pushes != st.pops) ok = false;
+        if (threads == 1 && st.cross_pushes != 0) ok = false;
+    }
+    CHECK(ok);
+
+    int thrown = 0;
+    try {
+        GraphPartition::build(csr, 0);
+    } catch (const std::invalid_argument &) {
+        ++thrown;
+    }
+    try {
+        DijkstraParallel engine(csr, start, 2);
+        engine.set_partition(std::make_shared<GraphPartition>(GraphPartition::build(csr, 3)));
+        engine.run();
+    } catch (const std::invalid_argument &) {
+        ++thrown;
+    }
+    CHECK(thrown == 2);
+}
+
+static void test_nearest_targets() {
+    Graph g = make_random_graph(900, 4, 30, 4242);
+    g.add_edge(10, 11, 0);
+    g.add_edge(11, 12, 0);
+    g.add_edge(12, 10, 0);
+    g.ensure_node("island");
+    CsrGraph csr(g);
+    const int island = static_cast<int>(g.size()) - 1;
+
+    // Повторяющаяся цель; при равных расстояниях выигрывает стоящая раньше
+    std::vector<int> targets = {40, 7, 40, 300, 5, 11};
+    NearestTargets table = NearestTargets::build(csr, targets);
+    CHECK(table.targets() == std::vector<int>({40, 7, 300, 5, 11}));
+
+    bool ok = true;
+    for (int v = 0; v < island; v += 11) {
+        auto full = DijkstraHeap(csr, v).run();
+        int best = -1;
+        for (int t: targets) {
+            if (full.dist[t] < Config::INF && (best == -1 || full.dist[t] < full.dist[best])) best = t;
+        }
+        if (table.nearest(v) != best) ok = false;
+        if (best == -1) {
+            if (table.distance(v) != Config::INF || !table.path(v).empty()) ok = false;
+            continue;
+        }
+        if (table.distance(v) != full.dist[best]) ok = false;
+
+        // Путь идёт по дугам графа и имеет длину distance(v)
+        auto path = table.path(v);
+        uint64_t len = 0;
+        for (size_t j = 1; j < path.size(); ++j) {
+            uint64_t w = Config::INF;
+            for (auto [to, wt]: g.adj[path[j - 1]])
+                if (to == path[j]) w = std::min<uint64_t>(w, wt);
+            len += w;
+        }
+        if (path.front() != v || path.back() != best || len != full.dist[best]) ok = false;
+    }
+    CHECK(ok);
+    CHECK(table.distance(11) == 0 && table.path(11) == std::vector<int>({11}));
+    CHECK(table.nearest(island) == -1 && table.path(island).empty());
+
+    // Набор целей сравнивается с точностью до повторов, но с учётом порядка
+    CHECK(table.built_for({40, 7, 300, 5, 11, 7}));
+    CHECK(!table.built_for({7, 40, 300, 5, 11}));
+    CHECK(!table.built_for({40, 7, 300, 5, 11, 1000}));
+
+    auto path = write_temp("");
+    table.save(path);
+    NearestTargets back = NearestTargets::load(path, csr);
+    bool same = back.targets() == table.targets();
+    for (int v = 0; v < (int) g.size(); ++v)
+        if (back.distance(v) != table.distance(v) || back.path(v) != table.path(v)) same = false;
+    CHECK(same);
+
+    g.add_edge(1, 2, 3);
+    CsrGraph other(g);
+    bool thrown = false;
+    try {
+        NearestTargets::load(path, other);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    unlink(path.c_str());
+
+    thrown = false;
+    try {
+        NearestTargets::build(csr, {0, -1});
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
 // Новые тесты для функциональных тестов из отчета
 
 static void test_small_graph_ABC() {
@@ -357,7 +1634,32 @@ A -> D [weight=3];
 int main() {
     test_linear_graph();
     test_unreachable_and_defaults();
+    test_name_table();
+    test_name_table_numeric_modes();
+    test_dot_parser_subset();
+    test_dot_parser_errors();
+    test_parallel_loader_matches_sequential();
     test_parallel_equals_sequential();
+    test_csr_matches_adjacency();
+    test_heap_engine_matches_linear();
+    test_bucket_engine_matches_linear();
+    test_early_stop_on_targets();
+    test_bidirectional_matches_full();
+    test_alt_landmarks_and_query();
+    test_contraction_hierarchy();
+    test_hub_labels();
+    test_query_workspace();
+    test_delta_stepping();
+    test_multiqueue();
+    test_worker_pool();
+    test_packed_distances();
+    test_distances_only();
+    test_batch_sources();
+    test_dense_engine();
+    test_vertex_order();
+    test_graph_partition();
+    test_nearest_targets();
+    test_binary_snapshot_roundtrip();
 
     // Новые тесты соответствующие таблицам в отчете
     test_small_graph_ABC();           // Тест 1 из таблицы
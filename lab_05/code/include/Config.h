@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -8,4 +9,14 @@ namespace Config {
     constexpr uint64_t INF_LIKE = std::numeric_limits<uint64_t>::max() / 2;
     constexpr int DEFAULT_THREADS = 1;
     constexpr int MAX_THREADS = 64;
+    // MultiQueue параллельного Дейкстры: очередей на поток и шаг выборки ошибки ранга
+    constexpr int PAR_QUEUE_FACTOR = 2;
+    constexpr uint64_t PAR_RANK_SAMPLE = 64;
+    // Вставок в буфере потока до сброса в очередь
+    constexpr int PAR_PUSH_BATCH = 64;
+    // Разбиение на части потоков: раунды распространения меток и допустимый перекос размеров
+    constexpr int PARTITION_ROUNDS = 8;
+    constexpr double PARTITION_IMBALANCE = 0.03;
+    constexpr int LOAD_THREADS = 0;
+    constexpr size_t PARALLEL_LOAD_MIN_BYTES = 1 << 20;
 }
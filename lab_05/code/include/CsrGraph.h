@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Graph;
+
+// Замороженное CSR-представление графа: смещения дуг каждой вершины
+// и непрерывные массивы концов и весов дуг.
+class CsrGraph {
+public:
+    CsrGraph() = default;
+    explicit CsrGraph(const Graph &g);
+
+    // Представление поверх чужих массивов (например, отображённого в память
+    // файла); массивы живут, пока жив owner.
+    CsrGraph(std::shared_ptr<const void> owner, size_t n, size_t m,
+             const uint64_t *offsets, const int *targets, const uint32_t *weights,
+             uint32_t max_weight);
+
+    CsrGraph(const CsrGraph &) = delete;
+    CsrGraph &operator=(const CsrGraph &) = delete;
+    CsrGraph(CsrGraph &&) = default;
+    CsrGraph &operator=(CsrGraph &&) = default;
+
+    size_t size() const { return n_; }
+    size_t edge_count() const { return m_; }
+
+    const uint64_t *offsets() const { return off_; }
+    const int *targets() const { return to_; }
+    const uint32_t *weights() const { return w_; }
+
+    uint64_t out_degree(int u) const { return off_[u + 1] - off_[u]; }
+
+    // Транспонированный граф: дуга u -> v веса w становится дугой v -> u
+    CsrGraph reversed() const;
+    // Перенумерованный граф: новая вершина i — старая order[i]; дуги вершины
+    // упорядочены по новым номерам концов
+    CsrGraph permuted(const std::vector<int> &order) const;
+
+    // Максимальный вес дуги (0 для графа без дуг), фиксируется при построении
+    uint32_t max_weight() const { return max_w_; }
+
+private:
+    std::vector<uint64_t> offsets_;
+    std::vector<int> targets_;
+    std::vector<uint32_t> weights_;
+    std::shared_ptr<const void> owner_;
+
+    size_t n_ = 0;
+    size_t m_ = 0;
+    uint32_t max_w_ = 0;
+    const uint64_t *off_ = zero_offset();
+    const int *to_ = nullptr;
+    const uint32_t *w_ = nullptr;
+
+    static const uint64_t *zero_offset() {
+        static const uint64_t zero = 0;
+        return &zero;
+    }
+};
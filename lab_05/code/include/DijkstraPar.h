@@ -1,26 +1,84 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "Config.h"
+#include "CsrGraph.h"
+#include "QueryWorkspace.h"
+#include "WorkerPool.h"
 
 class Graph;
+class GraphPartition;
 
 class DijkstraParResult {
 public:
     std::vector<uint64_t> dist;
     std::vector<int> parent;
+    uint64_t settled = 0;
 };
 
+// Счётчики планировщика MultiQueue за последний запуск
+class SchedulerStats {
+public:
+    uint64_t pops = 0;
+    uint64_t stale_pops = 0;// извлечения без работы: расстояние уже улучшено или за границей целей
+    uint64_t rank_samples = 0;
+    uint64_t rank_sum = 0;
+    uint64_t pushes = 0;
+    uint64_t cross_pushes = 0;// вставки в очереди чужого потока (очередь i принадлежит потоку i / c)
+    uint64_t locks = 0;// успешные захваты мьютексов очередей
+    uint64_t notifications = 0;// вызовы notify спящим потокам
+    uint64_t settled = 0;// вершины, раскрытые хотя бы раз (каждая считается один раз)
+    uint64_t reexpansions = 0;// повторные раскрытия вершины после улучшения её расстояния
+
+    double stale_ratio() const { return pops ? static_cast<double>(stale_pops) / static_cast<double>(pops) : 0.0; }
+    // Средняя ошибка ранга по выборке извлечений (каждое Config::PAR_RANK_SAMPLE-е)
+    double rank_error() const { return rank_samples ? static_cast<double>(rank_sum) / static_cast<double>(rank_samples) : 0.0; }
+    double cross_ratio() const { return pushes ? static_cast<double>(cross_pushes) / static_cast<double>(pushes) : 0.0; }
+};
+
+// Параллельный Дейкстра с ослабленной очередью MultiQueue: c * threads
+// последовательных куч под try_lock, вставка в случайную очередь, извлечение
+// из лучшей по верхушке из двух случайных
 class DijkstraParallel {
 public:
     DijkstraParallel(const Graph& g, int start, int threads);
+    DijkstraParallel(const CsrGraph& g, int start, int threads);
+    // Меняет размер пула, если он уже создан или передан через set_pool
     void set_threads(int t);
+    // Общий пул для движков, создаваемых на каждый запрос; без него движок
+    // заводит свой пул при первом run и переиспользует его
+    void set_pool(std::shared_ptr<WorkerPool> pool);
+    // c — число очередей на поток; больше c — меньше конфликтов, хуже порядок
+    void set_queue_factor(int c);
+    // Размер буфера вставок потока: полный буфер (или остаток после вершины)
+    // уходит в одну очередь за один захват
+    void set_push_batch(int b);
+    // Владельцы вершин: вершина части i вставляется в одну из c очередей
+    // потока i, поток извлекает сначала из своих очередей, затем крадёт.
+    // Частей должно быть столько же, сколько потоков; nullptr — случайные очереди
+    void set_partition(std::shared_ptr<const GraphPartition> partition);
+    // Досрочная остановка: элемент очереди с ключом не меньше максимума
+    // текущих расстояний до целей уже не улучшит ни одну цель
+    void set_targets(const std::vector<int>& targets);
+    // Без родителей релаксация меняет только расстояние, parent в результате
+    // равен -1; путь восстанавливается recover_path по входящим дугам
+    void set_record_parents(bool record);
     DijkstraParResult run();
+    // Запрос в массивах ws: без выделения и инициализации O(n)
+    QueryView run(QueryWorkspace& ws);
+    const SchedulerStats& stats() const { return stats_; }
 private:
-    const Graph& g_;
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph& g_;
     int start_;
     int threads_;
+    int queue_factor_ = Config::PAR_QUEUE_FACTOR;
+    int push_batch_ = Config::PAR_PUSH_BATCH;
+    bool record_parents_ = true;
+    std::shared_ptr<WorkerPool> pool_;
+    std::shared_ptr<const GraphPartition> partition_;
+    std::vector<int> targets_;
+    SchedulerStats stats_;
 };
-
-
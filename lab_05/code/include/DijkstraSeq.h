@@ -1,14 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "Config.h"
+#include "CsrGraph.h"
+#include "QueryWorkspace.h"
 
 class DijkstraResult {
 public:
     std::vector<uint64_t> dist;
     std::vector<int> parent;
+    // Число вершин, расстояние до которых стало окончательным
+    uint64_t settled = 0;
 };
 
 class Graph;
@@ -16,11 +21,20 @@ class Graph;
 class DijkstraSequential {
 public:
     DijkstraSequential(const Graph &g, int start);
+    DijkstraSequential(const CsrGraph &g, int start);
+    // Поиск останавливается, как только окончательны расстояния до всех целей;
+    // dist и parent прочих вершин тогда могут быть неполными
+    void set_targets(const std::vector<int> &targets);
+    // Без родителей пишутся только расстояния, parent равен -1 (путь — recover_path)
+    void set_record_parents(bool record);
     DijkstraResult run();
+    // Запрос в массивах ws без выделения памяти; результат — вид на них
+    QueryView run(QueryWorkspace &ws);
 
 private:
-    const Graph &g_;
+    std::unique_ptr<CsrGraph> own_;
+    const CsrGraph &g_;
     int start_;
+    std::vector<int> targets_;
+    bool record_parents_ = true;
 };
-
-
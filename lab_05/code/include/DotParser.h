@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class DotStatement {
+public:
+    enum class Kind {
+        Node,
+        Edge
+    };
+
+    Kind kind = Kind::Node;
+    std::string_view from;
+    std::string_view to;
+    uint32_t weight = 1;
+};
+
+// Однопроходный разбор подмножества DOT без регулярных выражений:
+// объявления вершин `"a";` и дуги `"a" -> "b" [label=w];` (или weight=w).
+// Имена возвращаются как string_view на исходный текст.
+class DotParser {
+public:
+    explicit DotParser(std::string_view text) : text_(text) {}
+
+    bool next(DotStatement &st);
+
+    size_t position() const { return pos_; }
+
+private:
+    enum class TokenKind {
+        End,
+        Id,
+        Arrow,
+        LBracket,
+        RBracket,
+        Equals,
+        Semicolon,
+        Other
+    };
+
+    struct Token {
+        TokenKind kind = TokenKind::End;
+        std::string_view text;
+        bool quoted = false;
+    };
+
+    std::string_view text_;
+    size_t pos_ = 0;
+
+    Token peeked_;
+    bool has_peeked_ = false;
+
+    std::vector<std::string_view> chain_;
+    size_t chain_pos_ = 0;
+    uint32_t chain_weight_ = 1;
+
+    Token lex();
+    Token peek();
+    Token take();
+    void skip_space();
+    void skip_statement();
+    uint32_t parse_attrs();
+};
@@ -1,22 +1,29 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "NameTable.h"
+
 class Graph {
 public:
     std::vector<std::vector<std::pair<int, uint32_t>>> adj;
-    std::unordered_map<std::string, int> name_to_idx;
-    std::vector<std::string> idx_to_name;
+    NameTable names;
 
-    int ensure_node(const std::string &name);
-    std::optional<int> find_node(const std::string &name) const;
+    int ensure_node(std::string_view name);
+    std::optional<int> find_node(std::string_view name) const;
+    std::string name(int v) const { return names.name(v); }
 
     void add_edge(int u, int v, uint32_t w);
 
     size_t size() const { return adj.size(); }
 
     static Graph load_from_dot(const std::string &path);
+    static Graph load_from_dot_parallel(const std::string &path, int threads);
+
+    void save_binary(const std::string &path) const;
+    static Graph load_binary(const std::string &path);
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Интернированные имена вершин. Три режима хранения:
+//  - Dense:   имена "0".."n-1" в порядке появления, индекс равен числу —
+//             ни строк, ни хеш-таблицы;
+//  - Numeric: десятичные имена в другом порядке — два массива число<->индекс;
+//  - Strings: произвольные имена лежат подряд в одной арене, индекс —
+//             хеш-таблица с открытой адресацией (линейное пробирование),
+//             поиск по std::string_view без временных строк.
+// Переход идёт только в сторону более общего режима.
+class NameTable {
+public:
+    enum class Mode {
+        Dense,
+        Numeric,
+        Strings
+    };
+
+    int intern(std::string_view name);
+    std::optional<int> find(std::string_view name) const;
+    std::string name(int idx) const;
+
+    size_t size() const { return count_; }
+    size_t bytes() const { return arena_.size(); }
+    Mode mode() const { return mode_; }
+
+    void reserve(size_t names, size_t bytes);
+    void clear();
+
+private:
+    struct Slot {
+        uint32_t hash;
+        int idx;
+    };
+
+    Mode mode_ = Mode::Dense;
+    size_t count_ = 0;
+
+    std::vector<int> value_to_idx_;
+    std::vector<uint32_t> idx_to_value_;
+
+    std::string arena_;
+    std::vector<uint64_t> offsets_{0};
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+
+    static std::optional<uint32_t> parse_decimal(std::string_view name);
+    static uint32_t hash_of(std::string_view name);
+
+    std::string_view stored(int idx) const {
+        return {arena_.data() + offsets_[idx], static_cast<size_t>(offsets_[idx + 1] - offsets_[idx])};
+    }
+
+    int intern_numeric(uint32_t value);
+    int intern_string(std::string_view name);
+    void to_numeric();
+    void to_strings();
+    void rehash(size_t capacity);
+};
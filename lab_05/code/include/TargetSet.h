@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Множество помеченных вершин для досрочной остановки поиска.
+// Пустое множество означает «строить всё дерево кратчайших путей».
+// Хранится отсортированный список целей, а не массив на весь граф, чтобы
+// запрос с переиспользуемыми массивами не платил O(n) за подготовку.
+class TargetSet {
+public:
+    explicit TargetSet(const std::vector<int> &targets) : left_(targets) {
+        std::sort(left_.begin(), left_.end());
+        left_.erase(std::unique(left_.begin(), left_.end()), left_.end());
+        empty_ = left_.empty();
+    }
+
+    bool empty() const { return empty_; }
+
+    // Отмечает вершину окончательной; true, когда окончательны все цели
+    bool settle(int v) {
+        auto it = std::lower_bound(left_.begin(), left_.end(), v);
+        if (it == left_.end() || *it != v) {
+            return false;
+        }
+        left_.erase(it);
+        return left_.empty();
+    }
+
+private:
+    std::vector<int> left_;
+    bool empty_;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Долгоживущие потоки параллельного движка. Между запросами они спят на
+// условной переменной, поэтому запрос не платит за создание и join потоков.
+// Пул из size() потоков держит size() - 1 рабочих: индекс 0 выполняет
+// вызывающий поток. run() вызывается одним потоком за раз.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads = 1);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+    // Останавливает рабочих и запускает новых, только если размер изменился
+    void resize(int threads);
+    // Выполняет job(0) .. job(size() - 1) параллельно и ждёт завершения всех
+    void run(const std::function<void(int)> &job);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    const std::function<void(int)> *job_ = nullptr;
+    uint64_t generation_ = 0;// номер текущего задания; рабочий ждёт смены
+    int pending_ = 0;
+    bool stop_ = false;
+
+    void loop(int idx, uint64_t seen);
+    void stop_workers();
+};
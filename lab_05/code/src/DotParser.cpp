@@ -0,0 +1,269 @@
+#include "DotParser.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    bool is_id_char(unsigned char c) {
+        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' || c == '.' || c >= 0x80;
+    }
+
+    bool is_keyword(std::string_view s) {
+        return s == "digraph" || s == "graph" || s == "strict" || s == "subgraph" || s == "node" || s == "edge";
+    }
+
+    bool is_number(std::string_view s) {
+        if (s.empty()) {
+            return false;
+        }
+        for (char c: s) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint32_t parse_weight(std::string_view s) {
+        uint64_t val = 0;
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), val);
+        if (ec == std::errc::result_out_of_range || val > UINT32_MAX) {
+            throw std::runtime_error("Weight exceeds 32-bit range");
+        }
+        if (ec != std::errc() || ptr != s.data() + s.size()) {
+            throw std::runtime_error("Invalid weight: " + std::string(s));
+        }
+        return static_cast<uint32_t>(val);
+    }
+}// namespace
+
+void DotParser::skip_space() {
+    const size_t n = text_.size();
+    while (pos_ < n) {
+        char c = text_[pos_];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v') {
+            ++pos_;
+        } else if (c == '/' && pos_ + 1 < n && text_[pos_ + 1] == '/') {
+            size_t eol = text_.find('\n', pos_);
+            pos_ = eol == std::string_view::npos ? n : eol + 1;
+        } else if (c == '/' && pos_ + 1 < n && text_[pos_ + 1] == '*') {
+            size_t end = text_.find("*/", pos_ + 2);
+            pos_ = end == std::string_view::npos ? n : end + 2;
+        } else if (c == '#') {
+            size_t eol = text_.find('\n', pos_);
+            pos_ = eol == std::string_view::npos ? n : eol + 1;
+        } else {
+            break;
+        }
+    }
+}
+
+DotParser::Token DotParser::lex() {
+    skip_space();
+
+    Token t;
+    if (pos_ >= text_.size()) {
+        return t;
+    }
+
+    const char c = text_[pos_];
+    if (c == '"') {
+        size_t i = pos_ + 1;
+        while (i < text_.size() && text_[i] != '"') {
+            i += (text_[i] == '\\' && i + 1 < text_.size()) ? 2 : 1;
+        }
+        if (i >= text_.size()) {
+            throw std::runtime_error("DOT parse error: unterminated string at offset " + std::to_string(pos_));
+        }
+        t.kind = TokenKind::Id;
+        t.text = text_.substr(pos_ + 1, i - pos_ - 1);
+        t.quoted = true;
+        pos_ = i + 1;
+        return t;
+    }
+
+    if (is_id_char(static_cast<unsigned char>(c))) {
+        size_t i = pos_ + 1;
+        while (i < text_.size() && is_id_char(static_cast<unsigned char>(text_[i]))) {
+            ++i;
+        }
+        t.kind = TokenKind::Id;
+        t.text = text_.substr(pos_, i - pos_);
+        pos_ = i;
+        return t;
+    }
+
+    if (c == '-' && pos_ + 1 < text_.size() && text_[pos_ + 1] == '>') {
+        t.kind = TokenKind::Arrow;
+        pos_ += 2;
+        return t;
+    }
+
+    switch (c) {
+        case '[':
+            t.kind = TokenKind::LBracket;
+            break;
+        case ']':
+            t.kind = TokenKind::RBracket;
+            break;
+        case '=':
+            t.kind = TokenKind::Equals;
+            break;
+        case ';':
+            t.kind = TokenKind::Semicolon;
+            break;
+        default:
+            t.kind = TokenKind::Other;
+    }
+    t.text = text_.substr(pos_, 1);
+    ++pos_;
+    return t;
+}
+
+DotParser::Token DotParser::peek() {
+    if (!has_peeked_) {
+        peeked_ = lex();
+        has_peeked_ = true;
+    }
+    return peeked_;
+}
+
+DotParser::Token DotParser::take() {
+    if (has_peeked_) {
+        has_peeked_ = false;
+        return peeked_;
+    }
+    return lex();
+}
+
+void DotParser::skip_statement() {
+    while (true) {
+        TokenKind k = peek().kind;
+        if (k == TokenKind::End) {
+            return;
+        }
+        take();
+        if (k == TokenKind::Semicolon) {
+            return;
+        }
+    }
+}
+
+uint32_t DotParser::parse_attrs() {
+    // '[' уже прочитан; берётся первое из label/weight с числовым значением
+    uint32_t w = 1;
+    bool found = false;
+    while (true) {
+        Token t = take();
+        if (t.kind == TokenKind::End) {
+            throw std::runtime_error("DOT parse error: unterminated attribute list");
+        }
+        if (t.kind == TokenKind::RBracket) {
+            return w;
+        }
+        if (t.kind != TokenKind::Id || peek().kind != TokenKind::Equals) {
+            continue;
+        }
+        take();
+        Token val = take();
+        if (val.kind == TokenKind::RBracket) {
+            return w;
+        }
+        if (!found && !t.quoted && (t.text == "label" || t.text == "weight") && val.kind == TokenKind::Id && is_number(val.text)) {
+            w = parse_weight(val.text);
+            found = true;
+        }
+    }
+}
+
+bool DotParser::next(DotStatement &st) {
+    if (chain_pos_ + 1 < chain_.size()) {
+        st.kind = DotStatement::Kind::Edge;
+        st.from = chain_[chain_pos_];
+        st.to = chain_[chain_pos_ + 1];
+        st.weight = chain_weight_;
+        ++chain_pos_;
+        return true;
+    }
+
+    while (true) {
+        Token t = take();
+        if (t.kind == TokenKind::End) {
+            return false;
+        }
+        if (t.kind != TokenKind::Id) {
+            continue;
+        }
+
+        if (!t.quoted && is_keyword(t.text)) {
+            // Имя графа/подграфа после ключевого слова вершиной не является
+            Token nt = peek();
+            if (nt.kind == TokenKind::Id && (nt.quoted || !is_keyword(nt.text)) && t.text != "node" && t.text != "edge") {
+                take();
+            }
+            if (peek().kind == TokenKind::LBracket) {
+                take();
+                parse_attrs();
+            }
+            continue;
+        }
+
+        Token nt = peek();
+        if (nt.kind == TokenKind::Equals) {
+            take();
+            take();
+            continue;
+        }
+
+        if (nt.kind == TokenKind::Arrow) {
+            chain_.clear();
+            chain_.push_back(t.text);
+            bool broken = false;
+            while (peek().kind == TokenKind::Arrow) {
+                take();
+                Token to = take();
+                if (to.kind != TokenKind::Id) {
+                    broken = true;
+                    break;
+                }
+                chain_.push_back(to.text);
+            }
+            if (broken) {
+                chain_.clear();
+                skip_statement();
+                continue;
+            }
+
+            chain_weight_ = 1;
+            if (peek().kind == TokenKind::LBracket) {
+                take();
+                chain_weight_ = parse_attrs();
+            }
+            if (peek().kind == TokenKind::Semicolon) {
+                take();
+            }
+
+            st.kind = DotStatement::Kind::Edge;
+            st.from = chain_[0];
+            st.to = chain_[1];
+            st.weight = chain_weight_;
+            chain_pos_ = 1;
+            return true;
+        }
+
+        if (nt.kind == TokenKind::LBracket) {
+            take();
+            parse_attrs();
+        }
+        if (peek().kind == TokenKind::Semicolon) {
+            take();
+        }
+
+        st.kind = DotStatement::Kind::Node;
+        st.from = t.text;
+        st.to = {};
+        st.weight = 0;
+        return true;
+    }
+}
@@ -0,0 +1,77 @@
+#include "GraphPartition.h"
+#include "VertexOrder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+GraphPartition GraphPartition::build(const CsrGraph &g, int parts, int rounds) {
+    if (parts < 1) {
+        throw std::invalid_argument("Partition needs at least one part");
+    }
+    const size_t n = g.size();
+    GraphPartition p;
+    p.parts_ = parts;
+    p.edges_ = g.edge_count();
+    p.part_.resize(n);
+
+    // Отрезки порядка BFS уже связны: распространению меток остаётся править границы
+    const VertexOrder bfs = VertexOrder::compute(g, VertexOrder::Strategy::Bfs);
+    const std::vector<int> &order = bfs.order();
+    std::vector<size_t> size(parts, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const int part = static_cast<int>(i * static_cast<size_t>(parts) / std::max<size_t>(n, 1));
+        p.part_[order[i]] = part;
+        ++size[part];
+    }
+
+    const size_t cap = static_cast<size_t>(std::ceil(static_cast<double>(n) / parts * (1.0 + Config::PARTITION_IMBALANCE)));
+    CsrGraph rev = g.reversed();
+    std::vector<uint64_t> count(parts, 0);
+    std::vector<int> touched;
+    for (int round = 0; round < rounds; ++round) {
+        size_t moved = 0;
+        for (size_t v = 0; v < n; ++v) {
+            touched.clear();
+            auto add = [&](const CsrGraph &side) {
+                for (uint64_t e = side.offsets()[v]; e < side.offsets()[v + 1]; ++e) {
+                    const int q = p.part_[side.targets()[e]];
+                    if (count[q]++ == 0) {
+                        touched.push_back(q);
+                    }
+                }
+            };
+            add(g);
+            add(rev);
+
+            const int cur = p.part_[v];
+            int best = cur;
+            for (int q: touched) {
+                if (count[q] > count[best] && size[q] < cap) {
+                    best = q;
+                }
+            }
+            for (int q: touched) {
+                count[q] = 0;
+            }
+            if (best != cur) {
+                --size[cur];
+                ++size[best];
+                p.part_[v] = best;
+                ++moved;
+            }
+        }
+        if (moved == 0) {
+            break;
+        }
+    }
+
+    const uint64_t *off = g.offsets();
+    const int *to = g.targets();
+    for (size_t u = 0; u < n; ++u) {
+        for (uint64_t e = off[u]; e < off[u + 1]; ++e) {
+            p.cut_ += p.part_[u] != p.part_[to[e]];
+        }
+    }
+    return p;
+}
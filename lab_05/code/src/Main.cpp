@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
@@ -6,10 +7,13 @@
 #include <vector>
 
 #include <filesystem>
+#include <optional>
 
 #include "Config.h"
+#include "CsrGraph.h"
 #include "DijkstraSeq.h"
 #include "Graph.h"
+#include "GraphSnapshot.h"
 #include "Timer.h"
 
 static std::vector<std::string> split_csv(const std::string &s) {
@@ -92,9 +96,25 @@ int main(int argc, char **argv) {
     Timer timer;
 
     for (int i = 0; i < N; ++i) {
-        Graph g = Graph::load_from_dot(graph_file);
+        Graph g;
+        CsrGraph own_csr;
+        std::optional<GraphSnapshot> snap;
+        if (GraphSnapshot::is_snapshot(graph_file)) {
+            snap = GraphSnapshot::open(graph_file);
+        } else {
+            g = Graph::load_from_dot(graph_file);
+            own_csr = CsrGraph(g);
+        }
+        const CsrGraph &csr = snap ? snap->csr() : own_csr;
+
+        auto find_node = [&](const std::string &name) -> std::optional<int> {
+            return snap ? snap->find_node(name) : g.find_node(name);
+        };
+        auto name_of = [&](int v) -> std::string {
+            return snap ? std::string(snap->name(v)) : g.name(v);
+        };
 
-        auto start_id_opt = g.find_node(start_vertex_str);
+        auto start_id_opt = find_node(start_vertex_str);
         if (!start_id_opt) {
             throw std::runtime_error("Start node not found in graph: " + start_vertex_str);
         }
@@ -102,14 +122,15 @@ int main(int argc, char **argv) {
 
         std::vector<int> target_indices;
         for (const auto &name: target_vertex_strs) {
-            auto id = g.find_node(name);
+            auto id = find_node(name);
             if (!id) {
                 throw std::runtime_error("Target node not found in graph: " + name);
             }
             target_indices.push_back(*id);
         }
 
-        DijkstraSequential seq(g, start_index);
+        DijkstraSequential seq(csr, start_index);
+        seq.set_targets(target_indices);
         auto res = seq.run();
 
         std::filesystem::path in_path(graph_file);
@@ -139,7 +160,7 @@ int main(int argc, char **argv) {
         for (size_t j = 0; j < target_indices.size(); ++j) {
             int idx = target_indices[j];
             uint64_t d = res.dist[idx];
-            out << "  " << g.idx_to_name[idx] << ": ";
+            out << "  " << name_of(idx) << ": ";
             if (d >= Config::INF) {
                 out << "INF\n";
             } else {
@@ -150,7 +171,7 @@ int main(int argc, char **argv) {
                     auto path = reconstruct_path(idx, res.parent);
                     best_path_names.clear();
                     for (int v: path) {
-                        best_path_names.push_back(g.idx_to_name[v]);
+                        best_path_names.push_back(name_of(v));
                     }
                 }
             }
@@ -160,7 +181,7 @@ int main(int argc, char **argv) {
         if (best_target_index == -1) {
             out << "  Все помеченные вершины недостижимы.\n";
         } else {
-            out << "  Целевая вершина: " << g.idx_to_name[best_target_index] << "\n";
+            out << "  Целевая вершина: " << name_of(best_target_index) << "\n";
             out << "  Длина пути: " << best_dist << "\n";
             out << "  Путь: ";
             for (size_t j = 0; j < best_path_names.size(); ++j) {
@@ -169,6 +190,7 @@ int main(int argc, char **argv) {
             }
             out << "\n";
         }
+        out << "\nОбработано вершин: " << res.settled << "\n";
     }
 
     long long total_us = timer.us();
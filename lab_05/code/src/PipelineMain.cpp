@@ -6,6 +6,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <stdexcept>
 #include <string>
@@ -15,8 +16,12 @@
 #include <filesystem>
 
 #include "Config.h"
+#include "CsrGraph.h"
 #include "DijkstraPar.h"
 #include "Graph.h"
+#include "GraphSnapshot.h"
+#include "QueryWorkspace.h"
+#include "WorkerPool.h"
 
 
 using Clock = std::chrono::high_resolution_clock;
@@ -30,12 +35,27 @@ struct Request {
 
     // после ОУ1
     Graph graph;
+    CsrGraph csr;
+    std::optional<GraphSnapshot> snapshot;
     int start_index{-1};
     std::vector<int> target_indices;
 
-    // после ОУ2
-    std::vector<uint64_t> dist;
-    std::vector<int> parent;
+    // после ОУ2: только то, что нужно ОУ3, — массивы запроса переиспользуются
+    std::vector<uint64_t> target_dist;
+    std::vector<std::vector<int>> target_paths;
+    uint64_t settled{};
+
+    const CsrGraph &adjacency() const {
+        return snapshot ? snapshot->csr() : csr;
+    }
+
+    std::optional<int> find_node(const std::string &name) const {
+        return snapshot ? snapshot->find_node(name) : graph.find_node(name);
+    }
+
+    std::string node_name(int v) const {
+        return snapshot ? std::string(snapshot->name(v)) : graph.name(v);
+    }
 };
 
 enum class EventType {
@@ -93,9 +113,9 @@ static std::vector<std::string> split_csv(const std::string &s) {
     return out;
 }
 
-static std::vector<int> reconstruct_path(int target, const std::vector<int> &parent) {
+static std::vector<int> reconstruct_path(int target, const QueryView &result) {
     std::vector<int> path;
-    for (int v = target; v != -1; v = parent[v]) {
+    for (int v = target; v != -1; v = result.parent(v)) {
         path.push_back(v);
     }
     std::reverse(path.begin(), path.end());
@@ -187,9 +207,14 @@ int main(int argc, char **argv) {
             auto req = q1.pop();
             log_event(1, req->id, EventType::Start);
 
-            req->graph = Graph::load_from_dot(req->graph_file);
+            if (GraphSnapshot::is_snapshot(req->graph_file)) {
+                req->snapshot = GraphSnapshot::open(req->graph_file);
+            } else {
+                req->graph = Graph::load_from_dot_parallel(req->graph_file, Config::LOAD_THREADS);
+                req->csr = CsrGraph(req->graph);
+            }
 
-            auto start_id_opt = req->graph.find_node(req->start_node_name);
+            auto start_id_opt = req->find_node(req->start_node_name);
             if (!start_id_opt) {
                 throw std::runtime_error("Start node not found in graph: " + req->start_node_name);
             }
@@ -197,7 +222,7 @@ int main(int argc, char **argv) {
 
             req->target_indices.clear();
             for (const auto &name: req->target_node_names) {
-                auto id = req->graph.find_node(name);
+                auto id = req->find_node(name);
                 if (!id) {
                     throw std::runtime_error("Target node not found in graph: " + name);
                 }
@@ -211,14 +236,24 @@ int main(int argc, char **argv) {
 
     // ОУ2
     std::thread ou2([&]() {
+        QueryWorkspace ws;
+        // Потоки поиска живут всю стадию; движок каждого запроса их заимствует
+        auto pool = std::make_shared<WorkerPool>(k_threads);
         for (int i = 0; i < N; ++i) {
             auto req = q2.pop();
             log_event(2, req->id, EventType::Start);
 
-            DijkstraParallel par(req->graph, req->start_index, k_threads);
-            auto res = par.run();
-            req->dist = std::move(res.dist);
-            req->parent = std::move(res.parent);
+            DijkstraParallel par(req->adjacency(), req->start_index, k_threads);
+            par.set_pool(pool);
+            par.set_targets(req->target_indices);
+            QueryView res = par.run(ws);
+            req->target_dist.clear();
+            req->target_paths.clear();
+            for (int idx: req->target_indices) {
+                req->target_dist.push_back(res.dist(idx));
+                req->target_paths.push_back(res.dist(idx) < Config::INF ? reconstruct_path(idx, res) : std::vector<int>{});
+            }
+            req->settled = res.settled();
 
             log_event(2, req->id, EventType::End);
             q3.push(req);
@@ -257,8 +292,8 @@ int main(int argc, char **argv) {
 
             for (size_t j = 0; j < req->target_indices.size(); ++j) {
                 int idx = req->target_indices[j];
-                uint64_t d = req->dist[idx];
-                out << "  " << req->graph.idx_to_name[idx] << ": ";
+                uint64_t d = req->target_dist[j];
+                out << "  " << req->node_name(idx) << ": ";
                 if (d >= Config::INF) {
                     out << "INF\n";
                 } else {
@@ -266,10 +301,9 @@ int main(int argc, char **argv) {
                     if (d < best_dist) {
                         best_dist = d;
                         best_target_index = idx;
-                        auto path = reconstruct_path(idx, req->parent);
                         best_path_names.clear();
-                        for (int v: path) {
-                            best_path_names.push_back(req->graph.idx_to_name[v]);
+                        for (int v: req->target_paths[j]) {
+                            best_path_names.push_back(req->node_name(v));
                         }
                     }
                 }
@@ -279,7 +313,7 @@ int main(int argc, char **argv) {
             if (best_target_index == -1) {
                 out << "  Все помеченные вершины недостижимы.\n";
             } else {
-                out << "  Целевая вершина: " << req->graph.idx_to_name[best_target_index] << "\n";
+                out << "  Целевая вершина: " << req->node_name(best_target_index) << "\n";
                 out << "  Длина пути: " << best_dist << "\n";
                 out << "  Путь: ";
                 for (size_t j = 0; j < best_path_names.size(); ++j) {
@@ -288,6 +322,7 @@ int main(int argc, char **argv) {
                 }
                 out << "\n";
             }
+            out << "\nОбработано вершин: " << req->settled << "\n";
 
             out.close();
             log_event(3, req->id, EventType::End);
@@ -0,0 +1,124 @@
+#include "VertexOrder.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    // Неориентированный вид графа: исходящие дуги g и входящие (дуги rev)
+    class Undirected {
+    public:
+        explicit Undirected(const CsrGraph &g) : g(g), rev(g.reversed()) {}
+
+        uint64_t degree(int v) const { return g.out_degree(v) + rev.out_degree(v); }
+
+        template<typename F>
+        void for_each(int v, F &&f) const {
+            for (uint64_t e = g.offsets()[v]; e < g.offsets()[v + 1]; ++e) {
+                f(g.targets()[e]);
+            }
+            for (uint64_t e = rev.offsets()[v]; e < rev.offsets()[v + 1]; ++e) {
+                f(rev.targets()[e]);
+            }
+        }
+
+        const CsrGraph &g;
+        CsrGraph rev;
+    };
+
+    // Обход в ширину от s, дописывающий вершины в order; by_degree — соседи
+    // очередной вершины ставятся в очередь по возрастанию степени
+    void bfs(const Undirected &ug, int s, bool by_degree, std::vector<char> &seen, std::vector<int> &order) {
+        std::vector<int> next;
+        size_t head = order.size();
+        seen[s] = 1;
+        order.push_back(s);
+        while (head < order.size()) {
+            const int u = order[head++];
+            next.clear();
+            ug.for_each(u, [&](int v) {
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    next.push_back(v);
+                }
+            });
+            if (by_degree) {
+                std::stable_sort(next.begin(), next.end(),
+                                 [&](int a, int b) { return ug.degree(a) < ug.degree(b); });
+            }
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+}// namespace
+
+VertexOrder::Strategy VertexOrder::parse(const std::string &name) {
+    if (name == "bfs") {
+        return Strategy::Bfs;
+    }
+    if (name == "rcm") {
+        return Strategy::Rcm;
+    }
+    if (name == "degree") {
+        return Strategy::Degree;
+    }
+    throw std::invalid_argument("Unknown vertex order: " + name);
+}
+
+VertexOrder VertexOrder::compute(const CsrGraph &g, Strategy strategy) {
+    const int n = static_cast<int>(g.size());
+    Undirected ug(g);
+    std::vector<int> order;
+    order.reserve(n);
+
+    if (strategy == Strategy::Degree) {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int a, int b) { return ug.degree(a) > ug.degree(b); });
+        return VertexOrder(std::move(order));
+    }
+
+    // Кандидаты в корни компонент: для BFS — по номеру, для RCM — по степени
+    // (вершина наименьшей степени — дешёвое приближение периферийной)
+    std::vector<int> roots(n);
+    std::iota(roots.begin(), roots.end(), 0);
+    const bool rcm = strategy == Strategy::Rcm;
+    if (rcm) {
+        std::stable_sort(roots.begin(), roots.end(),
+                         [&](int a, int b) { return ug.degree(a) < ug.degree(b); });
+    }
+    std::vector<char> seen(n, 0);
+    for (int s: roots) {
+        if (!seen[s]) {
+            bfs(ug, s, rcm, seen, order);
+        }
+    }
+    if (rcm) {
+        std::reverse(order.begin(), order.end());
+    }
+    return VertexOrder(std::move(order));
+}
+
+VertexOrder::VertexOrder(std::vector<int> order) : order_(std::move(order)), rank_(order_.size()) {
+    for (size_t i = 0; i < order_.size(); ++i) {
+        rank_[order_[i]] = static_cast<int>(i);
+    }
+}
+
+void VertexOrder::restore(std::vector<uint64_t> &dist, std::vector<int> &parent) const {
+    const size_t n = order_.size();
+    std::vector<uint64_t> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[order_[i]] = dist[i];
+    }
+    dist = std::move(d);
+
+    if (parent.empty()) {
+        return;
+    }
+    std::vector<int> p(n);
+    for (size_t i = 0; i < n; ++i) {
+        p[order_[i]] = parent[i] == -1 ? -1 : order_[parent[i]];
+    }
+    parent = std::move(p);
+}